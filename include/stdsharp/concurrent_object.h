@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <coroutine>
 #include <optional>
 #include <shared_mutex>
 
@@ -11,6 +12,36 @@
 
 namespace stdsharp
 {
+    namespace details
+    {
+        // invokes the function once the lock awaitable resumes with the lock held
+        template<typename LockAwaitable, typename Func>
+        class locked_invoke_awaitable
+        {
+            LockAwaitable lock_;
+            Func func_;
+
+        public:
+            constexpr locked_invoke_awaitable(LockAwaitable lock, Func func):
+                lock_(::std::move(lock)), func_(::std::move(func))
+            {
+            }
+
+            [[nodiscard]] constexpr bool await_ready() { return lock_.await_ready(); }
+
+            constexpr auto await_suspend(const ::std::coroutine_handle<> handle)
+            {
+                return lock_.await_suspend(handle);
+            }
+
+            constexpr decltype(auto) await_resume()
+            {
+                lock_.await_resume();
+                return ::std::invoke(func_);
+            }
+        };
+    }
+
     template<typename T, concepts::shared_lockable Lockable = ::std::shared_mutex>
         requires ::std::default_initializable<Lockable> && concepts::basic_lockable<Lockable>
     class concurrent_object
@@ -216,6 +247,36 @@ namespace stdsharp
             };
         }
 
+        // Returns an awaitable that acquires the shared lock without blocking the awaiting
+        // coroutine, then invokes func and yields its result.
+        template<::std::invocable<const value_type&> Func, typename... Executor>
+            requires concepts::async_shared_lockable<Lockable, Executor...>
+        [[nodiscard]] auto async_read(Func func, Executor... executor) const&
+        {
+            return details::locked_invoke_awaitable{
+                lockable_.async_lock_shared(::std::move(executor)...),
+                [this, func = ::std::move(func)]() mutable -> decltype(auto)
+                {
+                    const ::std::shared_lock lock{lockable_, ::std::adopt_lock};
+                    return ::std::invoke(func, object_);
+                } //
+            };
+        }
+
+        template<::std::invocable<value_type&> Func, typename... Executor>
+            requires concepts::async_lockable<Lockable, Executor...>
+        [[nodiscard]] auto async_write(Func func, Executor... executor) &
+        {
+            return details::locked_invoke_awaitable{
+                lockable_.async_lock(::std::move(executor)...),
+                [this, func = ::std::move(func)]() mutable -> decltype(auto)
+                {
+                    const ::std::unique_lock lock{lockable_, ::std::adopt_lock};
+                    return ::std::invoke(func, object_);
+                } //
+            };
+        }
+
         constexpr const auto& lockable() const noexcept { return lockable_; }
 
     private:
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <optional>
+
+#include "memory/memory.h"
+#include "mutex/spin_mutex.h"
+#include "new/new.h"
+#include "scope.h"
+
+namespace stdsharp
+{
+    // Bounded multi-producer multi-consumer ring queue after Dmitry Vyukov's design. Every slot
+    // carries a sequence number telling whether it is ready for the producer or the consumer of
+    // the current lap, so producers and consumers only contend on their own position counter.
+    template<typename T, allocator_req Allocator = ::std::allocator<T>>
+        requires ::std::same_as<typename ::std::allocator_traits<Allocator>::value_type, T> &&
+        concepts::nothrow_move_constructible<T>
+    class bounded_concurrent_queue
+    {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = ::std::size_t;
+
+    private:
+        struct alignas(hardware_destructive_interference_size) slot
+        {
+            ::std::atomic<size_type> sequence;
+            alignas(T) ::std::array<::std::byte, sizeof(T)> storage;
+
+            explicit slot(const size_type seq) noexcept: sequence(seq) {}
+
+            [[nodiscard]] T* get() noexcept
+            {
+                return ::std::launder(reinterpret_cast<T*>(storage.data())); // NOLINT
+            }
+        };
+
+        using slot_allocator =
+            typename ::std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+        using slot_traits = ::std::allocator_traits<slot_allocator>;
+
+        [[no_unique_address]] slot_allocator allocator_;
+        size_type mask_;
+        typename slot_traits::pointer slots_;
+
+        alignas(hardware_destructive_interference_size) ::std::atomic<size_type> enqueue_pos_{0};
+        alignas(hardware_destructive_interference_size) ::std::atomic<size_type> dequeue_pos_{0};
+
+        [[nodiscard]] slot& slot_at(const size_type pos) const noexcept
+        {
+            return slots_[static_cast<::std::ptrdiff_t>(pos & mask_)];
+        }
+
+        [[nodiscard]] static constexpr auto
+            distance(const size_type seq, const size_type pos) noexcept
+        {
+            return static_cast<::std::ptrdiff_t>(seq - pos);
+        }
+
+        // Claims up to max_count consecutive positions from pos_counter whose slot sequence
+        // equals position + offset, returns the first claimed position and the claimed count.
+        [[nodiscard]] auto claim(
+            ::std::atomic<size_type>& pos_counter,
+            const size_type offset,
+            const size_type max_count //
+        ) const noexcept
+        {
+            auto pos = pos_counter.load(::std::memory_order_relaxed);
+
+            while(true)
+            {
+                size_type count = 0;
+                ::std::ptrdiff_t dif = 0;
+
+                for(; count < max_count; ++count)
+                {
+                    const auto current = pos + count;
+
+                    dif = distance(
+                        slot_at(current).sequence.load(::std::memory_order_acquire),
+                        current + offset //
+                    );
+
+                    if(dif != 0) break;
+                }
+
+                if(count == 0 && dif > 0)
+                {
+                    pos = pos_counter.load(::std::memory_order_relaxed);
+                    continue;
+                }
+
+                if(count == 0 ||
+                   pos_counter.compare_exchange_weak(pos, pos + count, ::std::memory_order_relaxed))
+                    return ::std::pair{pos, count};
+            }
+        }
+
+        template<typename... Args>
+        void fill(const size_type pos, Args&&... args) noexcept
+        {
+            auto& s = slot_at(pos);
+            ::std::construct_at(s.get(), ::std::forward<Args>(args)...);
+            s.sequence.store(pos + 1, ::std::memory_order_release);
+        }
+
+        void release(const size_type pos) noexcept
+        {
+            auto& s = slot_at(pos);
+            ::std::destroy_at(s.get());
+            s.sequence.store(pos + mask_ + 1, ::std::memory_order_release);
+        }
+
+        template<typename Func>
+        static void spin_until(Func func)
+        {
+            for(exponential_backoff backoff; !func();) backoff();
+        }
+
+        // the iterators are advanced past the moved elements
+        template<typename Iter>
+        [[nodiscard]] size_type push_some(Iter& first, const size_type count) noexcept
+        {
+            const auto [pos, claimed] = claim(enqueue_pos_, 0, count);
+
+            for(size_type i = 0; i < claimed; ++i, ++first) fill(pos + i, *first);
+
+            return claimed;
+        }
+
+        template<typename Out>
+        [[nodiscard]] size_type pop_some(Out& out, const size_type count)
+        {
+            const auto [pos, claimed] = claim(dequeue_pos_, 1, count);
+            size_type i = 0;
+            const auto release_rest = scope::make_scoped<scope::exit_fn_policy::on_exit>(
+                [&]() noexcept
+                {
+                    for(; i < claimed; ++i) release(pos + i); //
+                } //
+            );
+
+            for(; i < claimed; ++i)
+            {
+                *out = ::std::move(*slot_at(pos + i).get());
+                ++out;
+                release(pos + i);
+            }
+
+            return claimed;
+        }
+
+    public:
+        explicit bounded_concurrent_queue(const size_type capacity, const Allocator& alloc = {}):
+            allocator_(alloc),
+            mask_(::std::bit_ceil(::std::max(capacity, size_type{2})) - 1),
+            slots_(slot_traits::allocate(allocator_, mask_ + 1))
+        {
+            for(size_type i = 0; i <= mask_; ++i)
+                slot_traits::construct(allocator_, ::std::to_address(slots_ + i), i);
+        }
+
+        bounded_concurrent_queue(const bounded_concurrent_queue&) = delete;
+        bounded_concurrent_queue(bounded_concurrent_queue&&) = delete;
+        bounded_concurrent_queue& operator=(const bounded_concurrent_queue&) = delete;
+        bounded_concurrent_queue& operator=(bounded_concurrent_queue&&) = delete;
+
+        ~bounded_concurrent_queue()
+        {
+            while(try_pop()) {}
+
+            for(size_type i = 0; i <= mask_; ++i)
+                slot_traits::destroy(allocator_, ::std::to_address(slots_ + i));
+
+            slot_traits::deallocate(allocator_, slots_, mask_ + 1);
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept { return mask_ + 1; }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_; }
+
+        // approximate when there are concurrent modifications
+        [[nodiscard]] size_type size() const noexcept
+        {
+            const auto dequeue_pos = dequeue_pos_.load(::std::memory_order_relaxed);
+            const auto enqueue_pos = enqueue_pos_.load(::std::memory_order_relaxed);
+            const auto dif = distance(enqueue_pos, dequeue_pos);
+
+            return dif < 0 ? 0 : ::std::min(static_cast<size_type>(dif), capacity());
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+        template<typename... Args>
+            requires concepts::nothrow_constructible_from<T, Args...>
+        [[nodiscard]] bool try_emplace(Args&&... args) noexcept
+        {
+            const auto [pos, count] = claim(enqueue_pos_, 0, 1);
+
+            if(count == 0) return false;
+
+            fill(pos, ::std::forward<Args>(args)...);
+            return true;
+        }
+
+        [[nodiscard]] bool try_push(T value) noexcept { return try_emplace(::std::move(value)); }
+
+        void push(T value) noexcept
+        {
+            spin_until([&]() noexcept { return try_emplace(::std::move(value)); });
+        }
+
+        [[nodiscard]] ::std::optional<T> try_pop() noexcept
+        {
+            const auto [pos, count] = claim(dequeue_pos_, 1, 1);
+
+            if(count == 0) return ::std::nullopt;
+
+            ::std::optional<T> value{::std::move(*slot_at(pos).get())};
+            release(pos);
+            return value;
+        }
+
+        [[nodiscard]] T pop() noexcept
+        {
+            ::std::optional<T> value;
+            spin_until([&]() noexcept { return (value = try_pop()).has_value(); });
+            return ::std::move(*value);
+        }
+
+        template<::std::input_iterator Iter>
+            requires concepts::nothrow_constructible_from<T, ::std::iter_reference_t<Iter>>
+        size_type try_push_n(Iter first, const size_type count) noexcept
+        {
+            return push_some(first, count);
+        }
+
+        // waits for room until all count elements are pushed, other producers may interleave
+        template<::std::input_iterator Iter>
+            requires concepts::nothrow_constructible_from<T, ::std::iter_reference_t<Iter>>
+        void push_n(Iter first, size_type count) noexcept
+        {
+            spin_until(
+                [&]() noexcept
+                {
+                    count -= push_some(first, count);
+                    return count == 0;
+                } //
+            );
+        }
+
+        template<::std::output_iterator<T> Out>
+        size_type try_pop_n(Out out, const size_type count)
+        {
+            return pop_some(out, count);
+        }
+
+        // waits until count elements are popped, returns the output iterator past them
+        template<::std::output_iterator<T> Out>
+        Out pop_n(Out out, size_type count)
+        {
+            spin_until(
+                [&]
+                {
+                    count -= pop_some(out, count);
+                    return count == 0;
+                } //
+            );
+
+            return out;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,661 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "node_handle.h"
+
+namespace stdsharp
+{
+    inline constexpr struct sorted_unique_t
+    {
+    } sorted_unique{};
+
+    inline constexpr struct sorted_equivalent_t
+    {
+    } sorted_equivalent{};
+
+    // Associative container keeping its values sorted in a contiguous vector. Lookups are binary
+    // searches over adjacent memory, insertions and erasures shift the following elements.
+    // Map values are stored as mutable pairs, modifying the key of an element is undefined.
+    template<typename Key, typename Value, typename Compare, typename Allocator, bool Unique>
+    class flat_tree
+    {
+        static constexpr auto is_map = !::std::same_as<Key, Value>;
+
+        template<typename K>
+        static constexpr auto lookupable =
+            ::std::same_as<K, Key> || requires { typename Compare::is_transparent; };
+
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using key_compare = Compare;
+        using allocator_type = Allocator;
+        using container_type = ::std::vector<Value, Allocator>;
+        using size_type = typename container_type::size_type;
+        using difference_type = typename container_type::difference_type;
+        using reference = Value&;
+        using const_reference = const Value&;
+        using pointer = typename container_type::pointer;
+        using const_pointer = typename container_type::const_pointer;
+        using const_iterator = typename container_type::const_iterator;
+        using iterator =
+            ::std::conditional_t<is_map, typename container_type::iterator, const_iterator>;
+        using reverse_iterator = ::std::reverse_iterator<iterator>;
+        using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+        using node_type = value_node_handle<Value, Allocator>;
+        using insert_return_type = containers::insert_return_type<iterator, node_type>;
+
+        class value_compare
+        {
+            friend class flat_tree;
+
+            [[no_unique_address]] Compare compare_;
+
+            explicit value_compare(const Compare& compare): compare_(compare) {}
+
+        public:
+            [[nodiscard]] bool operator()(const Value& left, const Value& right) const
+            {
+                return compare_(key_of(left), key_of(right));
+            }
+        };
+
+    private:
+        container_type data_;
+        [[no_unique_address]] Compare compare_;
+
+        [[nodiscard]] static constexpr const Key& key_of(const Value& value) noexcept
+        {
+            if constexpr(is_map) return value.first;
+            else return value;
+        }
+
+        [[nodiscard]] iterator mutable_iterator(const const_iterator it) noexcept
+        {
+            return data_.begin() + (it - data_.cbegin());
+        }
+
+        template<typename K>
+        [[nodiscard]] const_iterator lower(const K& key) const
+        {
+            return ::std::partition_point(
+                data_.cbegin(),
+                data_.cend(),
+                [this, &key](const Value& v) { return compare_(key_of(v), key); } //
+            );
+        }
+
+        template<typename K>
+        [[nodiscard]] const_iterator upper(const K& key) const
+        {
+            return ::std::partition_point(
+                data_.cbegin(),
+                data_.cend(),
+                [this, &key](const Value& v) { return !compare_(key, key_of(v)); } //
+            );
+        }
+
+        // whether key can be inserted right before hint without breaking the order
+        [[nodiscard]] bool fits_before(const const_iterator hint, const Key& key) const
+        {
+            if constexpr(Unique)
+                return (hint == data_.cbegin() || compare_(key_of(*(hint - 1)), key)) &&
+                    (hint == data_.cend() || compare_(key, key_of(*hint)));
+            else
+                return (hint == data_.cbegin() || !compare_(key, key_of(*(hint - 1)))) &&
+                    (hint == data_.cend() || !compare_(key_of(*hint), key));
+        }
+
+        // sorts the values appended after old_size and merges them into the sorted prefix,
+        // for unique trees the first of the equivalent values stays
+        void merge_appended(const size_type old_size)
+        {
+            const auto middle = data_.begin() + static_cast<difference_type>(old_size);
+
+            ::std::stable_sort(middle, data_.end(), value_comp());
+            ::std::inplace_merge(data_.begin(), middle, data_.end(), value_comp());
+
+            if constexpr(Unique) erase_duplicates();
+        }
+
+        void erase_duplicates()
+        {
+            data_.erase(
+                ::std::unique(
+                    data_.begin(),
+                    data_.end(),
+                    [this](const Value& left, const Value& right)
+                    {
+                        return !compare_(key_of(left), key_of(right)); //
+                    }
+                ),
+                data_.end()
+            );
+        }
+
+        iterator insert_value(Value&& value)
+        {
+            if constexpr(Unique) return insert_unique(::std::move(value)).first;
+            else return data_.insert(upper(key_of(value)), ::std::move(value));
+        }
+
+        ::std::pair<iterator, bool> insert_unique(Value&& value)
+        {
+            const auto it = lower(key_of(value));
+
+            if(it != data_.cend() && !compare_(key_of(value), key_of(*it)))
+                return {mutable_iterator(it), false};
+
+            return {data_.insert(it, ::std::move(value)), true};
+        }
+
+        iterator insert_hint(const const_iterator hint, Value&& value)
+        {
+            if(fits_before(hint, key_of(value))) return data_.insert(hint, ::std::move(value));
+
+            return insert_value(::std::move(value));
+        }
+
+    public:
+        flat_tree() = default;
+
+        explicit flat_tree(const Compare& compare, const Allocator& alloc = Allocator{}):
+            data_(alloc), compare_(compare)
+        {
+        }
+
+        explicit flat_tree(const Allocator& alloc): data_(alloc) {}
+
+        template<::std::input_iterator InputIt>
+        flat_tree(
+            const InputIt first,
+            const InputIt last,
+            const Compare& compare = Compare{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            flat_tree(compare, alloc)
+        {
+            insert(first, last);
+        }
+
+        // the range must be sorted by compare and, for unique trees, free of equivalent keys
+        template<::std::input_iterator InputIt>
+        flat_tree(
+            const ::std::conditional_t<Unique, sorted_unique_t, sorted_equivalent_t>,
+            const InputIt first,
+            const InputIt last,
+            const Compare& compare = Compare{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            data_(first, last, alloc), compare_(compare)
+        {
+        }
+
+        flat_tree(
+            const ::std::initializer_list<Value> list,
+            const Compare& compare = Compare{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            flat_tree(list.begin(), list.end(), compare, alloc)
+        {
+        }
+
+        explicit flat_tree(container_type container, const Compare& compare = Compare{}):
+            data_(::std::move(container)), compare_(compare)
+        {
+            ::std::stable_sort(data_.begin(), data_.end(), value_comp());
+            if constexpr(Unique) erase_duplicates();
+        }
+
+        flat_tree(
+            const ::std::conditional_t<Unique, sorted_unique_t, sorted_equivalent_t>,
+            container_type container,
+            const Compare& compare = Compare{} //
+        ):
+            data_(::std::move(container)), compare_(compare)
+        {
+        }
+
+        flat_tree(const flat_tree& other, const Allocator& alloc):
+            data_(other.data_, alloc), compare_(other.compare_)
+        {
+        }
+
+        flat_tree(flat_tree&& other, const Allocator& alloc):
+            data_(::std::move(other.data_), alloc), compare_(other.compare_)
+        {
+        }
+
+        flat_tree& operator=(const ::std::initializer_list<Value> list)
+        {
+            clear();
+            insert(list);
+            return *this;
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept
+        {
+            return data_.get_allocator();
+        }
+
+        [[nodiscard]] iterator begin() noexcept { return data_.begin(); }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return data_.begin(); }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept { return data_.cbegin(); }
+
+        [[nodiscard]] iterator end() noexcept { return data_.end(); }
+
+        [[nodiscard]] const_iterator end() const noexcept { return data_.end(); }
+
+        [[nodiscard]] const_iterator cend() const noexcept { return data_.cend(); }
+
+        [[nodiscard]] reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+
+        [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator{end()};
+        }
+
+        [[nodiscard]] const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        [[nodiscard]] reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+
+        [[nodiscard]] const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator{begin()};
+        }
+
+        [[nodiscard]] const_reverse_iterator crend() const noexcept { return rend(); }
+
+        [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+
+        [[nodiscard]] size_type size() const noexcept { return data_.size(); }
+
+        [[nodiscard]] size_type max_size() const noexcept { return data_.max_size(); }
+
+        [[nodiscard]] size_type capacity() const noexcept { return data_.capacity(); }
+
+        void reserve(const size_type count) { data_.reserve(count); }
+
+        void shrink_to_fit() { data_.shrink_to_fit(); }
+
+        [[nodiscard]] const container_type& container() const noexcept { return data_; }
+
+        [[nodiscard]] key_compare key_comp() const { return compare_; }
+
+        [[nodiscard]] value_compare value_comp() const { return value_compare{compare_}; }
+
+        template<typename... Args>
+            requires ::std::constructible_from<Value, Args...>
+        auto emplace(Args&&... args)
+        {
+            Value value(::std::forward<Args>(args)...);
+
+            if constexpr(Unique) return insert_unique(::std::move(value));
+            else return insert_value(::std::move(value));
+        }
+
+        template<typename... Args>
+            requires ::std::constructible_from<Value, Args...>
+        iterator emplace_hint(const const_iterator hint, Args&&... args)
+        {
+            return insert_hint(hint, Value(::std::forward<Args>(args)...));
+        }
+
+        auto insert(const Value& value) { return emplace(value); }
+
+        auto insert(Value&& value) { return emplace(::std::move(value)); }
+
+        iterator insert(const const_iterator hint, const Value& value)
+        {
+            return emplace_hint(hint, value);
+        }
+
+        iterator insert(const const_iterator hint, Value&& value)
+        {
+            return emplace_hint(hint, ::std::move(value));
+        }
+
+        template<::std::input_iterator InputIt>
+        void insert(InputIt first, const InputIt last)
+        {
+            const auto old_size = data_.size();
+
+            for(; first != last; ++first) data_.emplace_back(*first);
+
+            merge_appended(old_size);
+        }
+
+        void insert(const ::std::initializer_list<Value> list) { insert(list.begin(), list.end()); }
+
+        // the range must be sorted by compare, merged in linear time
+        template<::std::input_iterator InputIt>
+        void insert(
+            const ::std::conditional_t<Unique, sorted_unique_t, sorted_equivalent_t>,
+            const InputIt first,
+            const InputIt last //
+        )
+        {
+            const auto old_size = data_.size();
+
+            data_.insert(data_.end(), first, last);
+            ::std::inplace_merge(
+                data_.begin(),
+                data_.begin() + static_cast<difference_type>(old_size),
+                data_.end(),
+                value_comp()
+            );
+
+            if constexpr(Unique) erase_duplicates();
+        }
+
+        auto insert(node_type&& node)
+        {
+            if constexpr(Unique)
+            {
+                if(node.empty())
+                    return insert_return_type{.position = end(), .inserted = false, .node = {}};
+
+                const auto it = lower(key_of(node.value()));
+
+                if(it != data_.cend() && !compare_(key_of(node.value()), key_of(*it)))
+                    return insert_return_type{
+                        .position = mutable_iterator(it),
+                        .inserted = false,
+                        .node = ::std::move(node) //
+                    };
+
+                return insert_return_type{
+                    .position = data_.insert(it, ::std::move(node.value())),
+                    .inserted = true,
+                    .node = {} //
+                };
+            }
+            else return node.empty() ? end() : insert_value(::std::move(node.value()));
+        }
+
+        iterator insert(const const_iterator hint, node_type&& node)
+        {
+            return node.empty() ? end() : insert_hint(hint, ::std::move(node.value()));
+        }
+
+        node_type extract(const const_iterator pos)
+        {
+            node_type node{::std::move(*mutable_iterator(pos)), get_allocator()};
+            data_.erase(pos);
+            return node;
+        }
+
+        node_type extract(const Key& key)
+        {
+            const auto it = find(key);
+            return it == end() ? node_type{} : extract(it);
+        }
+
+        iterator erase(const const_iterator pos) { return data_.erase(pos); }
+
+        // beats the heterogeneous key overload for mutable iterators
+        iterator erase(const iterator pos)
+            requires(!::std::same_as<iterator, const_iterator>)
+        {
+            return data_.erase(pos);
+        }
+
+        iterator erase(const const_iterator first, const const_iterator last)
+        {
+            return data_.erase(first, last);
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        size_type erase(const K& key)
+        {
+            const auto [first, last] = equal_range(key);
+            const auto count = static_cast<size_type>(last - first);
+
+            data_.erase(first, last);
+            return count;
+        }
+
+        void clear() noexcept { data_.clear(); }
+
+        void swap(flat_tree& other) noexcept
+        {
+            ::std::ranges::swap(data_, other.data_);
+            ::std::ranges::swap(compare_, other.compare_);
+        }
+
+        friend void swap(flat_tree& left, flat_tree& right) noexcept { left.swap(right); }
+
+        // moves the values whose keys aren't in *this, in linear time plus the lookups
+        void merge(flat_tree& source)
+        {
+            if(this == &source) return;
+
+            auto& source_data = source.data_;
+            auto moved = source_data.begin();
+
+            if constexpr(Unique)
+                moved = ::std::stable_partition(
+                    source_data.begin(),
+                    source_data.end(),
+                    [this](const Value& v) { return contains(key_of(v)); } //
+                );
+
+            const auto old_size = data_.size();
+
+            data_.insert(
+                data_.end(),
+                ::std::make_move_iterator(moved),
+                ::std::make_move_iterator(source_data.end())
+            );
+            source_data.erase(moved, source_data.end());
+            ::std::inplace_merge(
+                data_.begin(),
+                data_.begin() + static_cast<difference_type>(old_size),
+                data_.end(),
+                value_comp()
+            );
+        }
+
+        void merge(flat_tree&& source) { merge(source); }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] iterator find(const K& key)
+        {
+            return mutable_iterator(::std::as_const(*this).find(key));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] const_iterator find(const K& key) const
+        {
+            const auto it = lower(key);
+            return it != data_.cend() && !compare_(key, key_of(*it)) ? it : data_.cend();
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] size_type count(const K& key) const
+        {
+            if constexpr(Unique) return contains(key) ? 1 : 0;
+            else
+            {
+                const auto [first, last] = equal_range(key);
+                return static_cast<size_type>(last - first);
+            }
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return find(key) != data_.cend();
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] iterator lower_bound(const K& key)
+        {
+            return mutable_iterator(lower(key));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] const_iterator lower_bound(const K& key) const
+        {
+            return lower(key);
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] iterator upper_bound(const K& key)
+        {
+            return mutable_iterator(upper(key));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] const_iterator upper_bound(const K& key) const
+        {
+            return upper(key);
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] ::std::pair<iterator, iterator> equal_range(const K& key)
+        {
+            const auto [first, last] = ::std::as_const(*this).equal_range(key);
+            return {mutable_iterator(first), mutable_iterator(last)};
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] ::std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+        {
+            const auto first = lower(key);
+
+            if constexpr(Unique)
+                return {
+                    first,
+                    first != data_.cend() && !compare_(key, key_of(*first)) ? first + 1 : first //
+                };
+            else
+                return {
+                    first,
+                    ::std::partition_point(
+                        first,
+                        data_.cend(),
+                        [this, &key](const Value& v) { return !compare_(key, key_of(v)); } //
+                    ) //
+                };
+        }
+
+        template<typename K = Key>
+            requires is_map && lookupable<K>
+        [[nodiscard]] auto& at(const K& key)
+        {
+            const auto it = find(key);
+            if(it == end()) throw ::std::out_of_range{"flat_tree key not found"};
+            return it->second;
+        }
+
+        template<typename K = Key>
+            requires is_map && lookupable<K>
+        [[nodiscard]] const auto& at(const K& key) const
+        {
+            const auto it = find(key);
+            if(it == end()) throw ::std::out_of_range{"flat_tree key not found"};
+            return it->second;
+        }
+
+        template<typename K, typename... Args>
+            requires(is_map && Unique && ::std::constructible_from<Key, K>)
+        ::std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            const auto it = lower(key);
+
+            if(it != data_.cend() && !compare_(key, key_of(*it)))
+                return {mutable_iterator(it), false};
+
+            return {
+                data_.emplace(
+                    it,
+                    ::std::piecewise_construct,
+                    ::std::forward_as_tuple(::std::forward<K>(key)),
+                    ::std::forward_as_tuple(::std::forward<Args>(args)...) //
+                ),
+                true //
+            };
+        }
+
+        template<typename K, typename M>
+            requires(is_map && Unique && ::std::constructible_from<Key, K>)
+        ::std::pair<iterator, bool> insert_or_assign(K&& key, M&& mapped)
+        {
+            auto result = try_emplace(::std::forward<K>(key), ::std::forward<M>(mapped));
+            if(!result.second) result.first->second = ::std::forward<M>(mapped);
+            return result;
+        }
+
+        template<typename K = Key>
+            requires is_map && Unique && ::std::constructible_from<Key, K>
+        auto& operator[](K&& key)
+        {
+            return try_emplace(::std::forward<K>(key)).first->second;
+        }
+
+        [[nodiscard]] friend bool operator==(const flat_tree& left, const flat_tree& right)
+            requires ::std::equality_comparable<Value>
+        {
+            return left.data_ == right.data_;
+        }
+
+        [[nodiscard]] friend auto operator<=>(const flat_tree& left, const flat_tree& right)
+            requires ::std::three_way_comparable<Value>
+        {
+            return left.data_ <=> right.data_;
+        }
+
+        template<typename Predicate>
+        friend size_type erase_if(flat_tree& tree, Predicate predicate)
+        {
+            return ::std::erase_if(tree.data_, predicate);
+        }
+    };
+
+    template<
+        typename Key,
+        typename Compare = ::std::less<Key>,
+        typename Allocator = ::std::allocator<Key> // clang-format off
+    > // clang-format on
+    using flat_set = flat_tree<Key, Key, Compare, Allocator, true>;
+
+    template<
+        typename Key,
+        typename Compare = ::std::less<Key>,
+        typename Allocator = ::std::allocator<Key> // clang-format off
+    > // clang-format on
+    using flat_multiset = flat_tree<Key, Key, Compare, Allocator, false>;
+
+    template<
+        typename Key,
+        typename T,
+        typename Compare = ::std::less<Key>,
+        typename Allocator = ::std::allocator<::std::pair<Key, T>> // clang-format off
+    > // clang-format on
+    using flat_map = flat_tree<Key, ::std::pair<Key, T>, Compare, Allocator, true>;
+
+    template<
+        typename Key,
+        typename T,
+        typename Compare = ::std::less<Key>,
+        typename Allocator = ::std::allocator<::std::pair<Key, T>> // clang-format off
+    > // clang-format on
+    using flat_multimap = flat_tree<Key, ::std::pair<Key, T>, Compare, Allocator, false>;
+}
\ No newline at end of file
@@ -0,0 +1,1235 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include "node_handle.h"
+
+namespace stdsharp
+{
+    namespace details
+    {
+        // control byte of a hash table slot, full slots store the low 7 bits of the hash
+        using hash_ctrl_t = ::std::int8_t;
+
+        inline constexpr hash_ctrl_t hash_ctrl_empty = -128;
+        inline constexpr hash_ctrl_t hash_ctrl_deleted = -2;
+        inline constexpr hash_ctrl_t hash_ctrl_sentinel = -1;
+
+        [[nodiscard]] constexpr bool is_hash_ctrl_full(const hash_ctrl_t ctrl) noexcept
+        {
+            return ctrl >= 0;
+        }
+
+#if defined(__SSE2__)
+        // 16 control bytes matched at once with SSE2 compares
+        class hash_group
+        {
+            __m128i ctrl_;
+
+            [[nodiscard]] static ::std::uint16_t to_mask(const __m128i bytes) noexcept
+            {
+                return static_cast<::std::uint16_t>(_mm_movemask_epi8(bytes));
+            }
+
+        public:
+            using mask_type = ::std::uint16_t;
+
+            static constexpr ::std::size_t width = 16;
+
+            explicit hash_group(const hash_ctrl_t* const ctrl) noexcept:
+                ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) // NOLINT
+            {
+            }
+
+            [[nodiscard]] mask_type match(const hash_ctrl_t h2) const noexcept
+            {
+                return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+            }
+
+            [[nodiscard]] mask_type match_empty() const noexcept { return match(hash_ctrl_empty); }
+
+            [[nodiscard]] mask_type match_empty_or_deleted() const noexcept
+            {
+                return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl_sentinel), ctrl_));
+            }
+        };
+#else
+        // portable fallback matching 8 control bytes per group
+        class hash_group
+        {
+            const hash_ctrl_t* ctrl_;
+
+            template<typename Predicate>
+            [[nodiscard]] ::std::uint8_t to_mask(const Predicate predicate) const noexcept
+            {
+                ::std::uint8_t mask = 0;
+
+                for(::std::size_t i = 0; i < width; ++i)
+                    if(predicate(ctrl_[i])) mask |= static_cast<::std::uint8_t>(1U << i);
+
+                return mask;
+            }
+
+        public:
+            using mask_type = ::std::uint8_t;
+
+            static constexpr ::std::size_t width = 8;
+
+            explicit hash_group(const hash_ctrl_t* const ctrl) noexcept: ctrl_(ctrl) {}
+
+            [[nodiscard]] mask_type match(const hash_ctrl_t h2) const noexcept
+            {
+                return to_mask([h2](const hash_ctrl_t c) { return c == h2; });
+            }
+
+            [[nodiscard]] mask_type match_empty() const noexcept { return match(hash_ctrl_empty); }
+
+            [[nodiscard]] mask_type match_empty_or_deleted() const noexcept
+            {
+                return to_mask([](const hash_ctrl_t c) { return c < hash_ctrl_sentinel; });
+            }
+        };
+#endif
+
+        // control bytes of tables without storage, lookups stop at the first group
+        alignas(hash_group::width) inline constinit ::std::array<hash_ctrl_t, hash_group::width>
+            empty_hash_ctrl_group = []
+        {
+            ::std::array<hash_ctrl_t, hash_group::width> group{};
+            group.fill(hash_ctrl_empty);
+            group.front() = hash_ctrl_sentinel;
+            return group;
+        }();
+
+        // quadratic probing over groups, visits every group once for power of two tables
+        class hash_probe_seq
+        {
+            ::std::size_t mask_;
+            ::std::size_t offset_;
+            ::std::size_t index_ = 0;
+
+        public:
+            hash_probe_seq(const ::std::size_t hash, const ::std::size_t mask) noexcept:
+                mask_(mask), offset_(hash & mask)
+            {
+            }
+
+            [[nodiscard]] ::std::size_t offset() const noexcept { return offset_; }
+
+            [[nodiscard]] ::std::size_t offset(const ::std::size_t i) const noexcept
+            {
+                return (offset_ + i) & mask_;
+            }
+
+            void next() noexcept
+            {
+                index_ += hash_group::width;
+                offset_ = (offset_ + index_) & mask_;
+            }
+        };
+    }
+
+    // Open addressing hash table in the swiss table layout: a control byte per slot holding 7
+    // hash bits lets a whole group of slots be filtered by one compare before keys are touched.
+    // Map values are stored as mutable pairs, modifying the key of an element is undefined.
+    // Rehashing moves the elements, so it invalidates references as well as iterators.
+    template<
+        typename Key,
+        typename Value,
+        typename Hash,
+        typename KeyEqual,
+        allocator_req Allocator // clang-format off
+    > // clang-format on
+        requires ::std::same_as<typename ::std::allocator_traits<Allocator>::value_type, Value> &&
+        ::std::same_as<typename ::std::allocator_traits<Allocator>::pointer, Value*>
+    class hash_table
+    {
+        static constexpr auto is_map = !::std::same_as<Key, Value>;
+
+        template<typename K>
+        static constexpr auto lookupable = ::std::same_as<K, Key> || requires
+        {
+            typename Hash::is_transparent;
+            typename KeyEqual::is_transparent;
+        };
+
+        using ctrl_t = details::hash_ctrl_t;
+        using group = details::hash_group;
+        using traits = allocator_traits<Allocator>;
+        using ctrl_allocator =
+            typename ::std::allocator_traits<Allocator>::template rebind_alloc<ctrl_t>;
+
+        static constexpr auto cloned_bytes = group::width - 1;
+
+        template<bool Const>
+        class iterator_t
+        {
+            friend class hash_table;
+            friend class iterator_t<!Const>;
+
+            const ctrl_t* ctrl_ = nullptr;
+            Value* slot_ = nullptr;
+
+            iterator_t(const ctrl_t* const ctrl, Value* const slot) noexcept:
+                ctrl_(ctrl), slot_(slot)
+            {
+            }
+
+            // moves to the first full slot from the current one, stops at the sentinel
+            void skip_empty_or_deleted() noexcept
+            {
+                while(*ctrl_ < details::hash_ctrl_sentinel)
+                {
+                    const auto shift = static_cast<::std::size_t>(
+                        ::std::countr_one(group{ctrl_}.match_empty_or_deleted())
+                    );
+
+                    ctrl_ += shift;
+                    slot_ += shift;
+                }
+            }
+
+        public:
+            using iterator_category = ::std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = ::std::ptrdiff_t;
+            using pointer = ::std::conditional_t<Const, const Value*, Value*>;
+            using reference = ::std::conditional_t<Const, const Value&, Value&>;
+
+            iterator_t() = default;
+
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            iterator_t(const iterator_t<OtherConst>& other) noexcept:
+                ctrl_(other.ctrl_), slot_(other.slot_)
+            {
+            }
+
+            [[nodiscard]] reference operator*() const noexcept { return *slot_; }
+
+            [[nodiscard]] pointer operator->() const noexcept { return slot_; }
+
+            iterator_t& operator++() noexcept
+            {
+                ++ctrl_;
+                ++slot_;
+                skip_empty_or_deleted();
+                return *this;
+            }
+
+            iterator_t operator++(int) noexcept
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            [[nodiscard]] friend bool
+                operator==(const iterator_t& left, const iterator_t& right) noexcept
+            {
+                return left.slot_ == right.slot_;
+            }
+        };
+
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Allocator;
+        using size_type = typename traits::size_type;
+        using difference_type = typename traits::difference_type;
+        using reference = Value&;
+        using const_reference = const Value&;
+        using pointer = Value*;
+        using const_pointer = const Value*;
+        using const_iterator = iterator_t<true>;
+        using iterator = ::std::conditional_t<is_map, iterator_t<false>, const_iterator>;
+        using local_iterator = iterator;
+        using const_local_iterator = const_iterator;
+        using node_type = value_node_handle<Value, Allocator>;
+        using insert_return_type = containers::insert_return_type<iterator, node_type>;
+
+    private:
+        ctrl_t* ctrl_ = details::empty_hash_ctrl_group.data();
+        Value* slots_ = nullptr;
+        size_type capacity_ = 0;
+        size_type size_ = 0;
+        size_type growth_left_ = 0;
+        float max_load_factor_ = default_max_load_factor;
+        [[no_unique_address]] Hash hash_{};
+        [[no_unique_address]] KeyEqual equal_{};
+        [[no_unique_address]] Allocator allocator_{};
+
+        [[nodiscard]] static constexpr const Key& key_of(const Value& value) noexcept
+        {
+            if constexpr(is_map) return value.first;
+            else return value;
+        }
+
+        // spreads the hash so identity hashes of sequential keys don't share a probe start
+        template<typename K>
+        [[nodiscard]] ::std::size_t hash_of(const K& key) const
+        {
+            auto hash = static_cast<::std::uint64_t>(hash_(key));
+
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL; // NOLINT(*-magic-numbers)
+            hash ^= hash >> 33;
+
+            return static_cast<::std::size_t>(hash);
+        }
+
+        [[nodiscard]] static constexpr ::std::size_t h1(const ::std::size_t hash) noexcept
+        {
+            return hash >> 7;
+        }
+
+        [[nodiscard]] static constexpr ctrl_t h2(const ::std::size_t hash) noexcept
+        {
+            return static_cast<ctrl_t>(hash & 0x7f); // NOLINT(*-magic-numbers)
+        }
+
+        [[nodiscard]] static constexpr size_type ctrl_size(const size_type capacity) noexcept
+        {
+            return capacity + 1 + cloned_bytes;
+        }
+
+        // a small table may be filled up since its groups always contain the cloned empties
+        [[nodiscard]] size_type growth_limit(const size_type capacity) const noexcept
+        {
+            if(capacity < cloned_bytes) return capacity;
+
+            return ::std::min(
+                capacity - 1,
+                static_cast<size_type>(static_cast<float>(capacity) * max_load_factor_)
+            );
+        }
+
+        [[nodiscard]] static constexpr size_type normalize_capacity(const size_type count)
+        {
+            return count == 0 ? 0 : ::std::bit_ceil(count + 1) - 1;
+        }
+
+        [[nodiscard]] size_type capacity_for(const size_type count) const
+        {
+            if(count > max_size()) throw ::std::length_error{"hash_table too long"};
+
+            auto capacity = normalize_capacity(count);
+            while(growth_limit(capacity) < count) capacity = capacity * 2 + 1;
+            return capacity;
+        }
+
+        // writes the control byte and its clone after the sentinel
+        void set_ctrl(const size_type index, const ctrl_t ctrl) noexcept
+        {
+            ctrl_[index] = ctrl;
+            ctrl_[((index - cloned_bytes) & capacity_) + (cloned_bytes & capacity_)] = ctrl;
+        }
+
+        [[nodiscard]] iterator iterator_at(const size_type index) const noexcept
+        {
+            return {ctrl_ + index, slots_ + index};
+        }
+
+        // first full slot from index, or end
+        [[nodiscard]] iterator first_full_from(const size_type index) const noexcept
+        {
+            auto it = iterator_at(index);
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        [[nodiscard]] size_type index_of(const const_iterator it) const noexcept
+        {
+            return static_cast<size_type>(it.slot_ - slots_);
+        }
+
+        template<typename K>
+        [[nodiscard]] size_type find_index(const K& key, const ::std::size_t hash) const
+        {
+            const auto h2_value = h2(hash);
+
+            for(details::hash_probe_seq seq{h1(hash), capacity_};; seq.next())
+            {
+                const group g{ctrl_ + seq.offset()};
+
+                for(auto mask = g.match(h2_value); mask != 0; mask &= mask - 1)
+                {
+                    const auto index = seq.offset(::std::countr_zero(mask));
+                    if(equal_(key_of(slots_[index]), key)) return index;
+                }
+
+                if(g.match_empty() != 0) return capacity_;
+            }
+        }
+
+        [[nodiscard]] size_type find_first_non_full(const ::std::size_t hash) const noexcept
+        {
+            for(details::hash_probe_seq seq{h1(hash), capacity_};; seq.next())
+                if(const auto mask = group{ctrl_ + seq.offset()}.match_empty_or_deleted();
+                   mask != 0)
+                    return seq.offset(::std::countr_zero(mask));
+        }
+
+        void allocate_storage(const size_type capacity)
+        {
+            ctrl_allocator ctrl_alloc{allocator_};
+            const auto ctrl = ::std::allocator_traits<ctrl_allocator>::allocate(
+                ctrl_alloc,
+                ctrl_size(capacity)
+            );
+
+            try
+            {
+                slots_ = traits::allocate(allocator_, capacity);
+            }
+            catch(...)
+            {
+                ::std::allocator_traits<ctrl_allocator>::deallocate(
+                    ctrl_alloc,
+                    ctrl,
+                    ctrl_size(capacity)
+                );
+                throw;
+            }
+
+            ctrl_ = ctrl;
+            capacity_ = capacity;
+            reset_ctrl();
+        }
+
+        void deallocate_storage() noexcept
+        {
+            if(capacity_ == 0) return;
+
+            ctrl_allocator ctrl_alloc{allocator_};
+            ::std::allocator_traits<ctrl_allocator>::deallocate(
+                ctrl_alloc,
+                ctrl_,
+                ctrl_size(capacity_)
+            );
+            traits::deallocate(allocator_, slots_, capacity_);
+
+            ctrl_ = details::empty_hash_ctrl_group.data();
+            slots_ = nullptr;
+            capacity_ = growth_left_ = 0;
+        }
+
+        void reset_ctrl() noexcept
+        {
+            ::std::fill_n(ctrl_, ctrl_size(capacity_), details::hash_ctrl_empty);
+            ctrl_[capacity_] = details::hash_ctrl_sentinel;
+            growth_left_ = growth_limit(capacity_) - size_;
+        }
+
+        template<typename Func>
+        void for_each_full(Func func) const
+        {
+            for(size_type i = 0; i < capacity_; ++i)
+                if(details::is_hash_ctrl_full(ctrl_[i])) func(i);
+        }
+
+        void destroy_all() noexcept
+        {
+            for_each_full([this](const size_type i) { traits::destroy(allocator_, slots_ + i); });
+        }
+
+        void destroy_storage() noexcept
+        {
+            destroy_all();
+            size_ = 0;
+            deallocate_storage();
+        }
+
+        // moves the elements into a table of new_capacity slots, also drops the tombstones
+        void resize(const size_type new_capacity)
+        {
+            hash_table old{hash_, equal_, allocator_};
+
+            old.take_storage(*this);
+
+            if(new_capacity == 0) return;
+
+            try
+            {
+                allocate_storage(new_capacity);
+                old.for_each_full(
+                    [this, &old](const size_type i)
+                    {
+                        auto& value = old.slots_[i];
+                        const auto hash = hash_of(key_of(value));
+                        const auto index = find_first_non_full(hash);
+
+                        traits::construct(
+                            allocator_,
+                            slots_ + index,
+                            ::std::move_if_noexcept(value)
+                        );
+                        set_ctrl(index, h2(hash));
+                        ++size_;
+                        --growth_left_;
+                    }
+                );
+            }
+            catch(...)
+            {
+                destroy_storage();
+                take_storage(old);
+                throw;
+            }
+        }
+
+        // reuses the capacity when tombstones take most of the table, otherwise doubles it
+        void rehash_and_grow_if_necessary()
+        {
+            if(capacity_ > group::width && size_ * 32 <= capacity_ * 25) resize(capacity_);
+            else resize(capacity_ == 0 ? 1 : capacity_ * 2 + 1);
+        }
+
+        [[nodiscard]] size_type prepare_insert(const ::std::size_t hash)
+        {
+            auto index = find_first_non_full(hash);
+
+            if(growth_left_ == 0 && ctrl_[index] != details::hash_ctrl_deleted)
+            {
+                rehash_and_grow_if_necessary();
+                index = find_first_non_full(hash);
+            }
+
+            if(ctrl_[index] == details::hash_ctrl_empty) --growth_left_;
+            set_ctrl(index, h2(hash));
+            ++size_;
+            return index;
+        }
+
+        // empties the slot when no probe could have passed it, otherwise leaves a tombstone
+        void erase_meta(const size_type index) noexcept
+        {
+            --size_;
+
+            const auto before_index = (index - group::width) & capacity_;
+            const auto empty_after = group{ctrl_ + index}.match_empty();
+            const auto empty_before = group{ctrl_ + before_index}.match_empty();
+            const auto was_never_full = empty_before != 0 && empty_after != 0 &&
+                static_cast<::std::size_t>(
+                    ::std::countr_zero(empty_after) + ::std::countl_zero(empty_before)
+                ) < group::width;
+
+            set_ctrl(index, was_never_full ? details::hash_ctrl_empty : details::hash_ctrl_deleted);
+            if(was_never_full) ++growth_left_;
+        }
+
+        void erase_at(const size_type index) noexcept
+        {
+            traits::destroy(allocator_, slots_ + index);
+            erase_meta(index);
+        }
+
+        // finds key or constructs the value with construct in a new slot
+        template<typename K, typename Construct>
+        ::std::pair<iterator, bool> emplace_key(const K& key, Construct construct)
+        {
+            const auto hash = hash_of(key);
+
+            if(const auto index = find_index(key, hash); index != capacity_)
+                return {iterator_at(index), false};
+
+            const auto index = prepare_insert(hash);
+
+            try
+            {
+                construct(slots_ + index);
+            }
+            catch(...)
+            {
+                erase_meta(index);
+                throw;
+            }
+
+            return {iterator_at(index), true};
+        }
+
+        void take_storage(hash_table& other) noexcept
+        {
+            ctrl_ = ::std::exchange(other.ctrl_, details::empty_hash_ctrl_group.data());
+            slots_ = ::std::exchange(other.slots_, nullptr);
+            capacity_ = ::std::exchange(other.capacity_, 0);
+            size_ = ::std::exchange(other.size_, 0);
+            growth_left_ = ::std::exchange(other.growth_left_, 0);
+            max_load_factor_ = other.max_load_factor_;
+        }
+
+        void swap_storage(hash_table& other) noexcept
+        {
+            ::std::ranges::swap(ctrl_, other.ctrl_);
+            ::std::ranges::swap(slots_, other.slots_);
+            ::std::ranges::swap(capacity_, other.capacity_);
+            ::std::ranges::swap(size_, other.size_);
+            ::std::ranges::swap(growth_left_, other.growth_left_);
+            ::std::ranges::swap(max_load_factor_, other.max_load_factor_);
+            ::std::ranges::swap(hash_, other.hash_);
+            ::std::ranges::swap(equal_, other.equal_);
+        }
+
+        // copies the control bytes as is and the elements into the same slots
+        void copy_from(const hash_table& other)
+        {
+            if(other.size_ == 0) return;
+
+            allocate_storage(other.capacity_);
+            ::std::copy_n(other.ctrl_, ctrl_size(capacity_), ctrl_);
+
+            size_type constructed = 0;
+
+            try
+            {
+                for(; constructed < capacity_; ++constructed)
+                    if(details::is_hash_ctrl_full(ctrl_[constructed]))
+                        traits::construct(
+                            allocator_,
+                            slots_ + constructed,
+                            ::std::as_const(other.slots_[constructed])
+                        );
+            }
+            catch(...)
+            {
+                for(size_type i = 0; i < constructed; ++i)
+                    if(details::is_hash_ctrl_full(ctrl_[i]))
+                        traits::destroy(allocator_, slots_ + i);
+
+                deallocate_storage();
+                throw;
+            }
+
+            size_ = other.size_;
+            growth_left_ = other.growth_left_;
+        }
+
+        void move_elements_from(hash_table& other)
+        {
+            reserve(other.size_);
+            other.for_each_full(
+                [this, &other](const size_type i)
+                {
+                    insert(::std::move(other.slots_[i])); //
+                }
+            );
+            other.clear();
+        }
+
+    public:
+        static constexpr auto default_max_load_factor = 0.875F;
+
+        hash_table() = default;
+
+        explicit hash_table(
+            const size_type bucket_count,
+            const Hash& hash = Hash{},
+            const KeyEqual& equal = KeyEqual{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            hash_(hash), equal_(equal), allocator_(alloc)
+        {
+            rehash(bucket_count);
+        }
+
+        hash_table(const size_type bucket_count, const Allocator& alloc):
+            hash_table(bucket_count, Hash{}, KeyEqual{}, alloc)
+        {
+        }
+
+        hash_table(const size_type bucket_count, const Hash& hash, const Allocator& alloc):
+            hash_table(bucket_count, hash, KeyEqual{}, alloc)
+        {
+        }
+
+        explicit hash_table(const Allocator& alloc): allocator_(alloc) {}
+
+        hash_table(const Hash& hash, const KeyEqual& equal, const Allocator& alloc):
+            hash_(hash), equal_(equal), allocator_(alloc)
+        {
+        }
+
+        template<::std::input_iterator InputIt>
+        hash_table(
+            const InputIt first,
+            const InputIt last,
+            const size_type bucket_count = 0,
+            const Hash& hash = Hash{},
+            const KeyEqual& equal = KeyEqual{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            hash_table(bucket_count, hash, equal, alloc)
+        {
+            insert(first, last);
+        }
+
+        template<::std::input_iterator InputIt>
+        hash_table(
+            const InputIt first,
+            const InputIt last,
+            const size_type bucket_count,
+            const Allocator& alloc //
+        ):
+            hash_table(first, last, bucket_count, Hash{}, KeyEqual{}, alloc)
+        {
+        }
+
+        template<::std::input_iterator InputIt>
+        hash_table(
+            const InputIt first,
+            const InputIt last,
+            const size_type bucket_count,
+            const Hash& hash,
+            const Allocator& alloc //
+        ):
+            hash_table(first, last, bucket_count, hash, KeyEqual{}, alloc)
+        {
+        }
+
+        hash_table(
+            const ::std::initializer_list<Value> list,
+            const size_type bucket_count = 0,
+            const Hash& hash = Hash{},
+            const KeyEqual& equal = KeyEqual{},
+            const Allocator& alloc = Allocator{} //
+        ):
+            hash_table(list.begin(), list.end(), bucket_count, hash, equal, alloc)
+        {
+        }
+
+        hash_table(
+            const ::std::initializer_list<Value> list,
+            const size_type bucket_count,
+            const Allocator& alloc //
+        ):
+            hash_table(list, bucket_count, Hash{}, KeyEqual{}, alloc)
+        {
+        }
+
+        hash_table(
+            const ::std::initializer_list<Value> list,
+            const size_type bucket_count,
+            const Hash& hash,
+            const Allocator& alloc //
+        ):
+            hash_table(list, bucket_count, hash, KeyEqual{}, alloc)
+        {
+        }
+
+        hash_table(const hash_table& other):
+            hash_table(
+                other,
+                traits::select_on_container_copy_construction(other.allocator_) //
+            )
+        {
+        }
+
+        hash_table(const hash_table& other, const Allocator& alloc):
+            max_load_factor_(other.max_load_factor_),
+            hash_(other.hash_),
+            equal_(other.equal_),
+            allocator_(alloc)
+        {
+            copy_from(other);
+        }
+
+        hash_table(hash_table&& other) noexcept:
+            hash_(other.hash_), equal_(other.equal_), allocator_(::std::move(other.allocator_))
+        {
+            take_storage(other);
+        }
+
+        hash_table(hash_table&& other, const Allocator& alloc):
+            hash_table(other.hash_, other.equal_, alloc)
+        {
+            max_load_factor_ = other.max_load_factor_;
+
+            if(allocator_ == other.allocator_) take_storage(other);
+            else move_elements_from(other);
+        }
+
+        hash_table& operator=(const hash_table& other)
+        {
+            if(this == &other) return *this;
+
+            hash_table copy(
+                other,
+                traits::propagate_on_container_copy_assignment::value ? other.allocator_ :
+                                                                        allocator_
+            );
+
+            destroy_storage();
+            allocator_ = copy.allocator_;
+            swap_storage(copy);
+            return *this;
+        }
+
+        hash_table& operator=(hash_table&& other) noexcept(
+            traits::propagate_on_container_move_assignment::value ||
+            traits::is_always_equal::value
+        )
+        {
+            if(this == &other) return *this;
+
+            destroy_storage();
+            hash_ = other.hash_;
+            equal_ = other.equal_;
+            max_load_factor_ = other.max_load_factor_;
+
+            if constexpr(traits::propagate_on_container_move_assignment::value)
+            {
+                allocator_ = ::std::move(other.allocator_);
+                take_storage(other);
+            }
+            else if(allocator_ == other.allocator_) take_storage(other);
+            else move_elements_from(other);
+
+            return *this;
+        }
+
+        hash_table& operator=(const ::std::initializer_list<Value> list)
+        {
+            clear();
+            insert(list);
+            return *this;
+        }
+
+        ~hash_table() { destroy_storage(); }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_; }
+
+        [[nodiscard]] iterator begin() noexcept { return first_full_from(0); }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept { return first_full_from(0); }
+
+        [[nodiscard]] iterator end() noexcept { return iterator_at(capacity_); }
+
+        [[nodiscard]] const_iterator end() const noexcept { return cend(); }
+
+        [[nodiscard]] const_iterator cend() const noexcept { return iterator_at(capacity_); }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+
+        [[nodiscard]] size_type max_size() const noexcept
+        {
+            return ::std::min(
+                traits::max_size(allocator_),
+                static_cast<size_type>(::std::numeric_limits<difference_type>::max() / 2)
+            );
+        }
+
+        template<typename... Args>
+            requires(::std::constructible_from<Value, Args...>)
+        ::std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            if constexpr( //
+                sizeof...(Args) == 1 &&
+                (::std::same_as<::std::remove_cvref_t<Args>, Value> && ...) //
+            )
+                return emplace_key(
+                    key_of(args...),
+                    [&](Value* const slot)
+                    {
+                        traits::construct(allocator_, slot, ::std::forward<Args>(args)...); //
+                    }
+                );
+            else
+            {
+                Value value(::std::forward<Args>(args)...);
+
+                return emplace_key(
+                    key_of(value),
+                    [&](Value* const slot)
+                    {
+                        traits::construct(allocator_, slot, ::std::move(value)); //
+                    }
+                );
+            }
+        }
+
+        template<typename... Args>
+        iterator emplace_hint(const const_iterator /*unused*/, Args&&... args)
+        {
+            return emplace(::std::forward<Args>(args)...).first;
+        }
+
+        ::std::pair<iterator, bool> insert(const Value& value) { return emplace(value); }
+
+        ::std::pair<iterator, bool> insert(Value&& value) { return emplace(::std::move(value)); }
+
+        iterator insert(const const_iterator hint, const Value& value)
+        {
+            return emplace_hint(hint, value);
+        }
+
+        iterator insert(const const_iterator hint, Value&& value)
+        {
+            return emplace_hint(hint, ::std::move(value));
+        }
+
+        template<::std::input_iterator InputIt>
+        void insert(InputIt first, const InputIt last)
+        {
+            if constexpr(::std::forward_iterator<InputIt>)
+                reserve(size_ + static_cast<size_type>(::std::ranges::distance(first, last)));
+
+            for(; first != last; ++first) emplace(*first);
+        }
+
+        void insert(const ::std::initializer_list<Value> list) { insert(list.begin(), list.end()); }
+
+        insert_return_type insert(node_type&& node)
+        {
+            if(node.empty()) return {.position = end(), .inserted = false, .node = {}};
+
+            auto [it, inserted] = emplace_key(
+                key_of(node.value()),
+                [&](Value* const slot)
+                {
+                    traits::construct(allocator_, slot, ::std::move(node.value())); //
+                }
+            );
+
+            if(inserted) return {.position = it, .inserted = true, .node = {}};
+
+            return {.position = it, .inserted = false, .node = ::std::move(node)};
+        }
+
+        iterator insert(const const_iterator /*unused*/, node_type&& node)
+        {
+            return insert(::std::move(node)).position;
+        }
+
+        node_type extract(const const_iterator pos)
+        {
+            const auto index = index_of(pos);
+            node_type node{::std::move(slots_[index]), allocator_};
+
+            erase_at(index);
+            return node;
+        }
+
+        node_type extract(const iterator pos)
+            requires(!::std::same_as<iterator, const_iterator>)
+        {
+            return extract(const_iterator{pos});
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        node_type extract(const K& key)
+        {
+            const auto it = find(key);
+            return it == end() ? node_type{} : extract(it);
+        }
+
+        iterator erase(const const_iterator pos)
+        {
+            auto next = iterator_at(index_of(pos));
+
+            ++next;
+            erase_at(index_of(pos));
+            return next;
+        }
+
+        iterator erase(const iterator pos)
+            requires(!::std::same_as<iterator, const_iterator>)
+        {
+            return erase(const_iterator{pos});
+        }
+
+        iterator erase(const_iterator first, const const_iterator last)
+        {
+            while(first != last) first = erase(first);
+            return iterator_at(index_of(last));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        size_type erase(const K& key)
+        {
+            const auto index = find_index(key, hash_of(key));
+
+            if(index == capacity_) return 0;
+
+            erase_at(index);
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            destroy_all();
+            size_ = 0;
+            if(capacity_ != 0) reset_ctrl();
+        }
+
+        void swap(hash_table& other) noexcept
+        {
+            if constexpr(traits::propagate_on_container_swap::value)
+                ::std::ranges::swap(allocator_, other.allocator_);
+
+            swap_storage(other);
+        }
+
+        friend void swap(hash_table& left, hash_table& right) noexcept { left.swap(right); }
+
+        // moves the values whose keys aren't in *this
+        void merge(hash_table& source)
+        {
+            if(this == &source) return;
+
+            source.for_each_full(
+                [this, &source](const size_type i)
+                {
+                    auto& value = source.slots_[i];
+                    const auto inserted = emplace_key(
+                        key_of(value),
+                        [&](Value* const slot)
+                        {
+                            traits::construct(allocator_, slot, ::std::move(value)); //
+                        }
+                    );
+
+                    if(inserted.second) source.erase_at(i);
+                }
+            );
+        }
+
+        void merge(hash_table&& source) { merge(source); }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] iterator find(const K& key)
+        {
+            return iterator_at(find_index(key, hash_of(key)));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] const_iterator find(const K& key) const
+        {
+            return iterator_at(find_index(key, hash_of(key)));
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] size_type count(const K& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return find_index(key, hash_of(key)) != capacity_;
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] ::std::pair<iterator, iterator> equal_range(const K& key)
+        {
+            const auto first = find(key);
+            return {first, first == end() ? first : ::std::ranges::next(first)};
+        }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] ::std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+        {
+            const auto first = find(key);
+            return {first, first == end() ? first : ::std::ranges::next(first)};
+        }
+
+        template<typename K = Key>
+            requires is_map && lookupable<K>
+        [[nodiscard]] auto& at(const K& key)
+        {
+            const auto it = find(key);
+            if(it == end()) throw ::std::out_of_range{"hash_table key not found"};
+            return it->second;
+        }
+
+        template<typename K = Key>
+            requires is_map && lookupable<K>
+        [[nodiscard]] const auto& at(const K& key) const
+        {
+            const auto it = find(key);
+            if(it == end()) throw ::std::out_of_range{"hash_table key not found"};
+            return it->second;
+        }
+
+        template<typename K, typename... Args>
+            requires(is_map && ::std::constructible_from<Key, K>)
+        ::std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            return emplace_key(
+                key,
+                [&](Value* const slot)
+                {
+                    traits::construct(
+                        allocator_,
+                        slot,
+                        ::std::piecewise_construct,
+                        ::std::forward_as_tuple(::std::forward<K>(key)),
+                        ::std::forward_as_tuple(::std::forward<Args>(args)...) //
+                    );
+                }
+            );
+        }
+
+        template<typename K, typename M>
+            requires(is_map && ::std::constructible_from<Key, K>)
+        ::std::pair<iterator, bool> insert_or_assign(K&& key, M&& mapped)
+        {
+            auto result = try_emplace(::std::forward<K>(key), ::std::forward<M>(mapped));
+            if(!result.second) result.first->second = ::std::forward<M>(mapped);
+            return result;
+        }
+
+        template<typename K = Key>
+            requires(is_map && ::std::constructible_from<Key, K>)
+        auto& operator[](K&& key)
+        {
+            return try_emplace(::std::forward<K>(key)).first->second;
+        }
+
+        // every slot is a bucket holding at most one element
+        [[nodiscard]] size_type bucket_count() const noexcept { return capacity_; }
+
+        [[nodiscard]] size_type max_bucket_count() const noexcept { return max_size(); }
+
+        template<typename K = Key>
+            requires lookupable<K>
+        [[nodiscard]] size_type bucket(const K& key) const
+        {
+            const auto hash = hash_of(key);
+            const auto index = find_index(key, hash);
+            return index == capacity_ ? h1(hash) & capacity_ : index;
+        }
+
+        [[nodiscard]] size_type bucket_size(const size_type n) const noexcept
+        {
+            return details::is_hash_ctrl_full(ctrl_[n]) ? 1 : 0;
+        }
+
+        [[nodiscard]] local_iterator begin(const size_type n) noexcept
+        {
+            return first_full_from(n);
+        }
+
+        [[nodiscard]] const_local_iterator begin(const size_type n) const noexcept
+        {
+            return cbegin(n);
+        }
+
+        [[nodiscard]] const_local_iterator cbegin(const size_type n) const noexcept
+        {
+            return first_full_from(n);
+        }
+
+        [[nodiscard]] local_iterator end(const size_type n) noexcept
+        {
+            auto it = first_full_from(n);
+            return bucket_size(n) == 0 ? it : ++it;
+        }
+
+        [[nodiscard]] const_local_iterator end(const size_type n) const noexcept
+        {
+            return cend(n);
+        }
+
+        [[nodiscard]] const_local_iterator cend(const size_type n) const noexcept
+        {
+            return const_cast<hash_table&>(*this).end(n); // NOLINT
+        }
+
+        [[nodiscard]] float load_factor() const noexcept
+        {
+            return capacity_ == 0 ? 0 : static_cast<float>(size_) / static_cast<float>(capacity_);
+        }
+
+        [[nodiscard]] float max_load_factor() const noexcept { return max_load_factor_; }
+
+        // clamped to [0.125, 1], tables always keep an empty slot for the probes to stop at
+        void max_load_factor(const float ml) noexcept
+        {
+            max_load_factor_ = ::std::clamp(ml, 0.125F, 1.F); // NOLINT(*-magic-numbers)
+        }
+
+        void rehash(const size_type count)
+        {
+            const auto capacity = ::std::max(normalize_capacity(count), capacity_for(size_));
+
+            if(capacity != capacity_ || growth_left_ != growth_limit(capacity_) - size_)
+                resize(capacity);
+        }
+
+        void reserve(const size_type count)
+        {
+            if(count > size_ + growth_left_) resize(capacity_for(count));
+        }
+
+        [[nodiscard]] hasher hash_function() const { return hash_; }
+
+        [[nodiscard]] key_equal key_eq() const { return equal_; }
+
+        [[nodiscard]] friend bool operator==(const hash_table& left, const hash_table& right)
+            requires ::std::equality_comparable<Value>
+        {
+            if(left.size_ != right.size_) return false;
+
+            for(const auto& value : left)
+                if(const auto it = right.find(key_of(value)); it == right.end() || *it != value)
+                    return false;
+
+            return true;
+        }
+
+        template<typename Predicate>
+        friend size_type erase_if(hash_table& table, Predicate predicate)
+        {
+            const auto old_size = table.size_;
+
+            table.for_each_full(
+                [&](const size_type i)
+                {
+                    if(predicate(::std::as_const(table.slots_[i]))) table.erase_at(i); //
+                }
+            );
+
+            return old_size - table.size_;
+        }
+    };
+
+    template<
+        typename Key,
+        typename Hash = ::std::hash<Key>,
+        typename KeyEqual = ::std::equal_to<Key>,
+        typename Allocator = ::std::allocator<Key> // clang-format off
+    > // clang-format on
+    using hash_set = hash_table<Key, Key, Hash, KeyEqual, Allocator>;
+
+    template<
+        typename Key,
+        typename T,
+        typename Hash = ::std::hash<Key>,
+        typename KeyEqual = ::std::equal_to<Key>,
+        typename Allocator = ::std::allocator<::std::pair<Key, T>> // clang-format off
+    > // clang-format on
+    using hash_map = hash_table<Key, ::std::pair<Key, T>, Hash, KeyEqual, Allocator>;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <optional>
+
+#include "containers.h"
+
+namespace stdsharp
+{
+    // Node handle of containers storing their values by value rather than in nodes, extracting
+    // moves the value out and inserting moves it back.
+    template<typename Value, typename Allocator>
+    class value_node_handle
+    {
+        ::std::optional<Value> value_;
+        ::std::optional<Allocator> allocator_;
+
+    public:
+        using value_type = Value;
+        using allocator_type = Allocator;
+
+        value_node_handle() = default;
+
+        value_node_handle(Value&& value, const Allocator& alloc):
+            value_(::std::move(value)), allocator_(alloc)
+        {
+        }
+
+        [[nodiscard]] bool empty() const noexcept { return !value_.has_value(); }
+
+        [[nodiscard]] explicit operator bool() const noexcept { return !empty(); }
+
+        [[nodiscard]] allocator_type get_allocator() const { return *allocator_; }
+
+        [[nodiscard]] value_type& value() noexcept { return *value_; }
+
+        [[nodiscard]] const value_type& value() const noexcept { return *value_; }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,679 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstring>
+#include <stdexcept>
+
+#include "containers.h"
+
+namespace stdsharp
+{
+    // Vector that stores up to InlineCapacity elements in place and only allocates from the
+    // allocator once it outgrows them. Heap growth takes the whole allocate_at_least result.
+    template<
+        typename T,
+        ::std::size_t InlineCapacity = 8,
+        allocator_req Allocator = ::std::allocator<T> // clang-format off
+    > // clang-format on
+        requires ::std::same_as<typename ::std::allocator_traits<Allocator>::value_type, T> &&
+        ::std::same_as<typename ::std::allocator_traits<Allocator>::pointer, T*>
+    class small_vector
+    {
+        using traits = allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = typename traits::size_type;
+        using difference_type = typename traits::difference_type;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = ::std::reverse_iterator<iterator>;
+        using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+
+        static constexpr auto inline_capacity = InlineCapacity;
+
+    private:
+        [[no_unique_address]] Allocator allocator_{};
+        T* data_ = inline_data();
+        size_type size_ = 0;
+        size_type capacity_ = inline_capacity;
+        alignas(T) ::std::array<::std::byte, sizeof(T) * inline_capacity> buffer_;
+
+        [[nodiscard]] T* inline_data() noexcept
+        {
+            return reinterpret_cast<T*>(buffer_.data()); // NOLINT
+        }
+
+        [[nodiscard]] const T* inline_data() const noexcept
+        {
+            return reinterpret_cast<const T*>(buffer_.data()); // NOLINT
+        }
+
+        [[nodiscard]] bool is_inline() const noexcept { return data_ == inline_data(); }
+
+        void destroy_range(T* first, T* const last) noexcept
+        {
+            for(; first != last; ++first) traits::destroy(allocator_, first);
+        }
+
+        // constructs [dest, dest + distance(first, last)), rolls back if an element throws
+        template<typename InputIt, typename Sentinel>
+        T* construct_range(InputIt first, const Sentinel last, T* const dest)
+        {
+            auto current = dest;
+
+            try
+            {
+                for(; first != last; ++first, ++current)
+                    traits::construct(allocator_, current, *first);
+            }
+            catch(...)
+            {
+                destroy_range(dest, current);
+                throw;
+            }
+
+            return current;
+        }
+
+        template<typename... Args>
+        T* construct_n(T* const dest, const size_type count, const Args&... args)
+        {
+            auto current = dest;
+
+            try
+            {
+                for(const auto last = dest + count; current != last; ++current)
+                    traits::construct(allocator_, current, args...);
+            }
+            catch(...)
+            {
+                destroy_range(dest, current);
+                throw;
+            }
+
+            return current;
+        }
+
+        void release_storage() noexcept
+        {
+            if(!is_inline()) traits::deallocate(allocator_, data_, capacity_);
+
+            data_ = inline_data();
+            capacity_ = inline_capacity;
+        }
+
+        void reset() noexcept
+        {
+            clear();
+            release_storage();
+        }
+
+        void check_length(const size_type count) const
+        {
+            if(count > max_size()) throw ::std::length_error{"small_vector too long"};
+        }
+
+        // moves the elements into new storage of at least min_capacity, new_element constructs
+        // the appended element before the old elements are moved, so it may refer to them
+        template<typename NewElement = ::std::nullptr_t>
+        void reallocate(const size_type min_capacity, NewElement new_element = nullptr)
+        {
+            constexpr auto appends = !::std::same_as<NewElement, ::std::nullptr_t>;
+            const auto [new_data, new_capacity] =
+                traits::allocate_at_least(allocator_, min_capacity);
+
+            try
+            {
+                if constexpr(appends) new_element(new_data + size_);
+
+                try
+                {
+                    if constexpr(::std::is_trivially_copyable_v<T>)
+                        ::std::memcpy(
+                            static_cast<void*>(new_data),
+                            static_cast<const void*>(data_),
+                            size_ * sizeof(T)
+                        );
+                    else
+                        construct_range(
+                            ::std::make_move_iterator(begin()),
+                            ::std::make_move_iterator(end()),
+                            new_data
+                        );
+                }
+                catch(...)
+                {
+                    if constexpr(appends) traits::destroy(allocator_, new_data + size_);
+                    throw;
+                }
+            }
+            catch(...)
+            {
+                traits::deallocate(allocator_, new_data, new_capacity);
+                throw;
+            }
+
+            destroy_range(begin(), end());
+            release_storage();
+            data_ = new_data;
+            capacity_ = new_capacity;
+        }
+
+        [[nodiscard]] size_type grown_capacity(const size_type min_capacity) const
+        {
+            check_length(min_capacity);
+            return ::std::max(min_capacity, ::std::min(capacity_ * 2, max_size()));
+        }
+
+        void grow(const size_type min_capacity)
+        {
+            if(min_capacity > capacity_) reallocate(grown_capacity(min_capacity));
+        }
+
+        // takes the elements of other, *this must be empty and inline
+        void take(small_vector&& other) noexcept(concepts::nothrow_move_constructible<T>)
+        {
+            if(other.is_inline())
+            {
+                construct_range(
+                    ::std::make_move_iterator(other.begin()),
+                    ::std::make_move_iterator(other.end()),
+                    data_
+                );
+                size_ = other.size_;
+                other.clear();
+                return;
+            }
+
+            data_ = ::std::exchange(other.data_, other.inline_data());
+            size_ = ::std::exchange(other.size_, 0);
+            capacity_ = ::std::exchange(other.capacity_, inline_capacity);
+        }
+
+        // moves the elements appended after old_size to index
+        iterator rotate_to(const difference_type index, const size_type old_size)
+        {
+            const auto first = begin() + index;
+            ::std::rotate(first, begin() + old_size, end());
+            return first;
+        }
+
+        template<typename InputIt, typename Sentinel>
+        void append(InputIt first, const Sentinel last)
+        {
+            if constexpr(::std::forward_iterator<InputIt>)
+            {
+                const auto count = static_cast<size_type>(::std::ranges::distance(first, last));
+
+                grow(size_ + count);
+                construct_range(first, last, end());
+                size_ += count;
+            }
+            else
+                for(; first != last; ++first) emplace_back(*first);
+        }
+
+    public:
+        small_vector() noexcept(concepts::nothrow_default_initializable<Allocator>) = default;
+
+        explicit small_vector(const Allocator& alloc) noexcept: allocator_(alloc) {}
+
+        small_vector(const size_type count, const T& value, const Allocator& alloc = Allocator{}):
+            small_vector(alloc)
+        {
+            assign(count, value);
+        }
+
+        explicit small_vector(const size_type count, const Allocator& alloc = Allocator{}):
+            small_vector(alloc)
+        {
+            resize(count);
+        }
+
+        template<::std::input_iterator InputIt>
+        small_vector(const InputIt first, const InputIt last, const Allocator& alloc = Allocator{}):
+            small_vector(alloc)
+        {
+            append(first, last);
+        }
+
+        small_vector(const ::std::initializer_list<T> list, const Allocator& alloc = Allocator{}):
+            small_vector(list.begin(), list.end(), alloc)
+        {
+        }
+
+        small_vector(const small_vector& other):
+            small_vector(
+                other,
+                traits::select_on_container_copy_construction(other.allocator_) //
+            )
+        {
+        }
+
+        small_vector(const small_vector& other, const Allocator& alloc):
+            small_vector(other.begin(), other.end(), alloc)
+        {
+        }
+
+        small_vector(small_vector&& other) noexcept(concepts::nothrow_move_constructible<T>):
+            allocator_(::std::move(other.allocator_))
+        {
+            take(::std::move(other));
+        }
+
+        small_vector(small_vector&& other, const Allocator& alloc): small_vector(alloc)
+        {
+            if(allocator_ == other.allocator_) take(::std::move(other));
+            else
+            {
+                append(
+                    ::std::make_move_iterator(other.begin()),
+                    ::std::make_move_iterator(other.end())
+                );
+                other.clear();
+            }
+        }
+
+        small_vector& operator=(const small_vector& other)
+        {
+            if(this == &other) return *this;
+
+            if constexpr(traits::propagate_on_container_copy_assignment::value)
+                if(allocator_ != other.allocator_)
+                {
+                    reset();
+                    allocator_ = other.allocator_;
+                }
+
+            assign(other.begin(), other.end());
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(
+            concepts::nothrow_move_constructible<T> &&
+            (traits::propagate_on_container_move_assignment::value ||
+             traits::is_always_equal::value)
+        )
+        {
+            if(this == &other) return *this;
+
+            if constexpr(traits::propagate_on_container_move_assignment::value)
+            {
+                reset();
+                allocator_ = ::std::move(other.allocator_);
+                take(::std::move(other));
+            }
+            else if(allocator_ == other.allocator_)
+            {
+                reset();
+                take(::std::move(other));
+            }
+            else
+            {
+                assign(
+                    ::std::make_move_iterator(other.begin()),
+                    ::std::make_move_iterator(other.end())
+                );
+                other.clear();
+            }
+
+            return *this;
+        }
+
+        small_vector& operator=(const ::std::initializer_list<T> list)
+        {
+            assign(list);
+            return *this;
+        }
+
+        ~small_vector() { reset(); }
+
+        void assign(const size_type count, const T& value)
+        {
+            if(count > capacity_)
+            {
+                small_vector other(count, value, allocator_);
+                reset();
+                take(::std::move(other));
+                return;
+            }
+
+            const auto assigned = ::std::min(count, size_);
+
+            ::std::fill_n(begin(), assigned, value);
+
+            if(count > size_) construct_n(end(), count - size_, value);
+            else destroy_range(begin() + count, end());
+
+            size_ = count;
+        }
+
+        template<::std::input_iterator InputIt>
+        void assign(const InputIt first, const InputIt last)
+        {
+            clear();
+            append(first, last);
+        }
+
+        void assign(const ::std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_; }
+
+        [[nodiscard]] reference at(const size_type pos)
+        {
+            if(pos >= size_) throw ::std::out_of_range{"small_vector index out of range"};
+            return data_[pos];
+        }
+
+        [[nodiscard]] const_reference at(const size_type pos) const
+        {
+            if(pos >= size_) throw ::std::out_of_range{"small_vector index out of range"};
+            return data_[pos];
+        }
+
+        [[nodiscard]] reference operator[](const size_type pos) noexcept { return data_[pos]; }
+
+        [[nodiscard]] const_reference operator[](const size_type pos) const noexcept
+        {
+            return data_[pos];
+        }
+
+        [[nodiscard]] reference front() noexcept { return *data_; }
+
+        [[nodiscard]] const_reference front() const noexcept { return *data_; }
+
+        [[nodiscard]] reference back() noexcept { return data_[size_ - 1]; }
+
+        [[nodiscard]] const_reference back() const noexcept { return data_[size_ - 1]; }
+
+        [[nodiscard]] T* data() noexcept { return data_; }
+
+        [[nodiscard]] const T* data() const noexcept { return data_; }
+
+        [[nodiscard]] iterator begin() noexcept { return data_; }
+
+        [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept { return data_; }
+
+        [[nodiscard]] iterator end() noexcept { return data_ + size_; }
+
+        [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+
+        [[nodiscard]] const_iterator cend() const noexcept { return data_ + size_; }
+
+        [[nodiscard]] reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+
+        [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+        {
+            return const_reverse_iterator{end()};
+        }
+
+        [[nodiscard]] const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+        [[nodiscard]] reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+
+        [[nodiscard]] const_reverse_iterator rend() const noexcept
+        {
+            return const_reverse_iterator{begin()};
+        }
+
+        [[nodiscard]] const_reverse_iterator crend() const noexcept { return rend(); }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+
+        [[nodiscard]] size_type max_size() const noexcept
+        {
+            return ::std::min<size_type>(
+                traits::max_size(allocator_),
+                ::std::numeric_limits<difference_type>::max()
+            );
+        }
+
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+        void reserve(const size_type new_capacity)
+        {
+            check_length(new_capacity);
+            if(new_capacity > capacity_) reallocate(new_capacity);
+        }
+
+        void shrink_to_fit()
+        {
+            if(is_inline() || size_ == capacity_) return;
+
+            if(size_ <= inline_capacity)
+            {
+                auto* const heap = data_;
+                const auto heap_capacity = capacity_;
+
+                data_ = inline_data();
+                capacity_ = inline_capacity;
+
+                try
+                {
+                    construct_range(
+                        ::std::make_move_iterator(heap),
+                        ::std::make_move_iterator(heap + size_),
+                        data_
+                    );
+                }
+                catch(...)
+                {
+                    data_ = heap;
+                    capacity_ = heap_capacity;
+                    throw;
+                }
+
+                destroy_range(heap, heap + size_);
+                traits::deallocate(allocator_, heap, heap_capacity);
+            }
+            else
+            {
+                small_vector other{allocator_};
+
+                other.reserve(size_);
+                other.append(::std::make_move_iterator(begin()), ::std::make_move_iterator(end()));
+                reset();
+                take(::std::move(other));
+            }
+        }
+
+        void clear() noexcept
+        {
+            destroy_range(begin(), end());
+            size_ = 0;
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... args)
+        {
+            if(size_ == capacity_)
+                reallocate(
+                    grown_capacity(size_ + 1),
+                    [&](T* const ptr)
+                    {
+                        traits::construct(allocator_, ptr, ::std::forward<Args>(args)...); //
+                    }
+                );
+            else traits::construct(allocator_, end(), ::std::forward<Args>(args)...);
+
+            return data_[size_++];
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+
+        void push_back(T&& value) { emplace_back(::std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            --size_;
+            traits::destroy(allocator_, end());
+        }
+
+        template<typename... Args>
+        iterator emplace(const const_iterator pos, Args&&... args)
+        {
+            const auto old_size = size_;
+            const auto index = pos - cbegin();
+
+            emplace_back(::std::forward<Args>(args)...);
+            return rotate_to(index, old_size);
+        }
+
+        iterator insert(const const_iterator pos, const T& value) { return emplace(pos, value); }
+
+        iterator insert(const const_iterator pos, T&& value)
+        {
+            return emplace(pos, ::std::move(value));
+        }
+
+        iterator insert(const const_iterator pos, const size_type count, const T& value)
+        {
+            const auto old_size = size_;
+            const auto index = pos - cbegin();
+
+            if(size_ + count > capacity_)
+            {
+                // value may refer to an element
+                const T copy = value;
+                grow(size_ + count);
+                construct_n(end(), count, copy);
+            }
+            else construct_n(end(), count, value);
+
+            size_ += count;
+
+            return rotate_to(index, old_size);
+        }
+
+        template<::std::input_iterator InputIt>
+        iterator insert(const const_iterator pos, const InputIt first, const InputIt last)
+        {
+            const auto old_size = size_;
+            const auto index = pos - cbegin();
+
+            append(first, last);
+
+            return rotate_to(index, old_size);
+        }
+
+        iterator insert(const const_iterator pos, const ::std::initializer_list<T> list)
+        {
+            return insert(pos, list.begin(), list.end());
+        }
+
+        iterator erase(const const_iterator pos) { return erase(pos, pos + 1); }
+
+        iterator erase(const const_iterator first, const const_iterator last)
+        {
+            const auto first_it = begin() + (first - cbegin());
+
+            if(first == last) return first_it;
+
+            const auto new_end = ::std::move(begin() + (last - cbegin()), end(), first_it);
+
+            destroy_range(new_end, end());
+            size_ = static_cast<size_type>(new_end - begin());
+
+            return first_it;
+        }
+
+        void resize(const size_type count)
+        {
+            if(count <= size_)
+            {
+                destroy_range(begin() + count, end());
+                size_ = count;
+                return;
+            }
+
+            grow(count);
+            construct_n(end(), count - size_);
+            size_ = count;
+        }
+
+        void resize(const size_type count, const T& value)
+        {
+            if(count <= size_) resize(count);
+            else insert(cend(), count - size_, value);
+        }
+
+        void swap(small_vector& other) noexcept(concepts::nothrow_move_constructible<T>)
+        {
+            if(this == &other) return;
+
+            if(!is_inline() && !other.is_inline())
+            {
+                ::std::swap(data_, other.data_);
+                ::std::swap(size_, other.size_);
+                ::std::swap(capacity_, other.capacity_);
+
+                if constexpr(traits::propagate_on_container_swap::value)
+                    ::std::ranges::swap(allocator_, other.allocator_);
+
+                return;
+            }
+
+            small_vector temp{::std::move(other)};
+
+            other.take(::std::move(*this));
+            take(::std::move(temp));
+
+            if constexpr(traits::propagate_on_container_swap::value)
+            {
+                other.allocator_ = allocator_;
+                allocator_ = temp.allocator_;
+            }
+        }
+
+        friend void swap(small_vector& left, small_vector& right) //
+            noexcept(noexcept(left.swap(right)))
+        {
+            left.swap(right);
+        }
+
+        [[nodiscard]] friend bool operator==(const small_vector& left, const small_vector& right)
+            requires ::std::equality_comparable<T>
+        {
+            return ::std::ranges::equal(left, right);
+        }
+
+        [[nodiscard]] friend auto operator<=>(const small_vector& left, const small_vector& right)
+            requires ::std::three_way_comparable<T>
+        {
+            return ::std::lexicographical_compare_three_way(
+                left.begin(),
+                left.end(),
+                right.begin(),
+                right.end()
+            );
+        }
+
+        template<typename U>
+        friend size_type erase(small_vector& container, const U& value)
+        {
+            return erase_if(container, [&value](const T& v) { return v == value; });
+        }
+
+        template<typename Predicate>
+        friend size_type erase_if(small_vector& container, Predicate predicate)
+        {
+            const auto it = ::std::remove_if(container.begin(), container.end(), predicate);
+            const auto count = static_cast<size_type>(container.end() - it);
+
+            container.erase(it, container.end());
+            return count;
+        }
+    };
+}
\ No newline at end of file
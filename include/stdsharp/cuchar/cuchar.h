@@ -21,31 +21,36 @@ namespace stdsharp
         {
             ::std::mbstate_t mb = std::mbstate_t();
             ::std::string res(MB_CUR_MAX, '\0');
+            ::std::size_t size{};
 
             constexpr_pattern_match::from_type<CharT>(
                 [&](const ::std::type_identity<wchar_t>)
                 {
-                    return ::std::wcrtomb(res.data(), character, &mb); // NOLINT(*-mt-unsafe)
+                    size = ::std::wcrtomb(res.data(), character, &mb); // NOLINT(*-mt-unsafe)
                 },
 #if __cpp_lib_char8_t >= 201907L
     #ifndef __clang__
                 [&](const ::std::type_identity<char8_t>)
                 {
-                    return ::std::c8rtomb(res.data(), character, &mb); //
+                    size = ::std::c8rtomb(res.data(), character, &mb); //
                 },
     #endif
 #endif
                 [&](const ::std::type_identity<char16_t>)
                 {
-                    return ::std::c16rtomb(res.data(), character, &mb); //
+                    size = ::std::c16rtomb(res.data(), character, &mb); //
                 },
                 [&](const ::std::type_identity<char32_t>)
                 {
-                    return ::std::c32rtomb(res.data(), character, &mb); //
+                    size = ::std::c32rtomb(res.data(), character, &mb); //
                 } // clang-format off
             ); // clang-format on
 
-            if(errno == EILSEQ) throw ::std::runtime_error("invalid character");
+            if(size == static_cast<::std::size_t>(-1))
+                throw ::std::runtime_error("invalid character");
+
+            res.resize(size);
+            return res;
         }
 
         template<typename... Args>
@@ -0,0 +1,520 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#include "../concepts/concepts.h"
+
+namespace stdsharp
+{
+    // code units of UTF-8, UTF-16 or UTF-32 by their size, char is UTF-8 and wchar_t is UTF-16 or
+    // UTF-32 as wide as it is
+    template<typename CharT>
+    concept utf_char = concepts::same_as_any<CharT, char, char8_t, char16_t, char32_t, wchar_t> &&
+        (sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+    namespace details
+    {
+        template<typename Str>
+        using utf_string_view_t = decltype(::std::basic_string_view{::std::declval<const Str&>()});
+    }
+
+    // strings, string views and null terminated strings of utf_char
+    template<typename Str>
+    concept utf_string = requires { typename details::utf_string_view_t<Str>; } &&
+        utf_char<typename details::utf_string_view_t<Str>::value_type>;
+
+    struct transcode_result
+    {
+        // input units consumed, the offset of the first invalid character on error
+        ::std::size_t read;
+
+        // output units written
+        ::std::size_t written;
+
+        // illegal_byte_sequence for invalid input, value_too_large when the output is full
+        ::std::errc ec;
+    };
+
+    namespace details
+    {
+        template<typename CharT>
+        using utf_unit_t = ::std::conditional_t<
+            sizeof(CharT) == 1,
+            ::std::uint8_t,
+            ::std::conditional_t<sizeof(CharT) == 2, ::std::uint16_t, ::std::uint32_t>>;
+
+        template<typename CharT>
+        [[nodiscard]] constexpr utf_unit_t<CharT> utf_unit(const CharT c) noexcept
+        {
+            return static_cast<utf_unit_t<CharT>>(c);
+        }
+
+        // output units a single input unit may need at most
+        template<typename From, typename To>
+        inline constexpr ::std::size_t utf_max_expansion = sizeof(To) == 1 ?
+            (sizeof(From) == 1 ? 1 : sizeof(From) == 2 ? 3 : 4) :
+            (sizeof(To) == 2 && sizeof(From) == 4 ? 2 : 1);
+
+        struct utf_decoded
+        {
+            char32_t code_point;
+
+            // units of the character, 0 for invalid ones
+            ::std::uint8_t length;
+        };
+
+        [[nodiscard]] constexpr bool is_utf8_continuation(const ::std::uint8_t c) noexcept
+        {
+            return (c & 0xC0U) == 0x80U;
+        }
+
+        // rejects overlong forms, surrogates and code points above U+10FFFF
+        template<typename CharT>
+            requires(sizeof(CharT) == 1)
+        [[nodiscard]] constexpr utf_decoded
+            decode_utf(const CharT* const in, const ::std::size_t size) noexcept
+        {
+            const auto b0 = utf_unit(in[0]);
+
+            if(b0 < 0x80U) return {b0, 1};
+
+            const auto cont = [&](const ::std::size_t i) noexcept
+            {
+                return i < size && is_utf8_continuation(utf_unit(in[i]));
+            };
+            const auto bits = [&](const ::std::size_t i) noexcept
+            {
+                return static_cast<char32_t>(utf_unit(in[i]) & 0x3FU);
+            };
+
+            if(b0 < 0xC2U) return {0, 0};
+
+            if(b0 < 0xE0U)
+            {
+                if(!cont(1)) return {0, 0};
+                return {static_cast<char32_t>((b0 & 0x1FU) << 6U) | bits(1), 2};
+            }
+
+            if(b0 < 0xF0U)
+            {
+                if(!cont(1) || !cont(2)) return {0, 0};
+
+                const auto b1 = utf_unit(in[1]);
+                if((b0 == 0xE0U && b1 < 0xA0U) || (b0 == 0xEDU && b1 >= 0xA0U)) return {0, 0};
+
+                return {
+                    static_cast<char32_t>((b0 & 0x0FU) << 12U) | (bits(1) << 6U) | bits(2),
+                    3 //
+                };
+            }
+
+            if(b0 < 0xF5U)
+            {
+                if(!cont(1) || !cont(2) || !cont(3)) return {0, 0};
+
+                const auto b1 = utf_unit(in[1]);
+                if((b0 == 0xF0U && b1 < 0x90U) || (b0 == 0xF4U && b1 >= 0x90U)) return {0, 0};
+
+                return {
+                    static_cast<char32_t>((b0 & 0x07U) << 18U) | (bits(1) << 12U) |
+                        (bits(2) << 6U) | bits(3),
+                    4 //
+                };
+            }
+
+            return {0, 0};
+        }
+
+        // rejects unpaired surrogates
+        template<typename CharT>
+            requires(sizeof(CharT) == 2)
+        [[nodiscard]] constexpr utf_decoded
+            decode_utf(const CharT* const in, const ::std::size_t size) noexcept
+        {
+            const auto u0 = utf_unit(in[0]);
+
+            if(u0 < 0xD800U || u0 >= 0xE000U) return {u0, 1};
+
+            if(u0 >= 0xDC00U || size < 2) return {0, 0};
+
+            const auto u1 = utf_unit(in[1]);
+
+            if(u1 < 0xDC00U || u1 >= 0xE000U) return {0, 0};
+
+            return {0x10000U + ((u0 - 0xD800U) << 10U) + (u1 - 0xDC00U), 2};
+        }
+
+        // rejects surrogates and code points above U+10FFFF
+        template<typename CharT>
+            requires(sizeof(CharT) == 4)
+        [[nodiscard]] constexpr utf_decoded
+            decode_utf(const CharT* const in, const ::std::size_t /*unused*/) noexcept
+        {
+            const auto u = utf_unit(in[0]);
+
+            if(u < 0xD800U || (u >= 0xE000U && u < 0x110000U)) return {u, 1};
+
+            return {0, 0};
+        }
+
+        // writes the code point, returns the units written or 0 if the output is too small
+        template<typename CharT>
+        [[nodiscard]] constexpr ::std::size_t
+            encode_utf(const char32_t cp, CharT* const out, const ::std::size_t size) noexcept
+        {
+            const auto put = [out](const ::std::size_t i, const ::std::uint32_t unit) noexcept
+            {
+                out[i] = static_cast<CharT>(unit); //
+            };
+
+            if constexpr(sizeof(CharT) == 1)
+            {
+                if(cp < 0x80U)
+                {
+                    if(size < 1) return 0;
+                    put(0, cp);
+                    return 1;
+                }
+
+                if(cp < 0x800U)
+                {
+                    if(size < 2) return 0;
+                    put(0, 0xC0U | (cp >> 6U));
+                    put(1, 0x80U | (cp & 0x3FU));
+                    return 2;
+                }
+
+                if(cp < 0x10000U)
+                {
+                    if(size < 3) return 0;
+                    put(0, 0xE0U | (cp >> 12U));
+                    put(1, 0x80U | ((cp >> 6U) & 0x3FU));
+                    put(2, 0x80U | (cp & 0x3FU));
+                    return 3;
+                }
+
+                if(size < 4) return 0;
+                put(0, 0xF0U | (cp >> 18U));
+                put(1, 0x80U | ((cp >> 12U) & 0x3FU));
+                put(2, 0x80U | ((cp >> 6U) & 0x3FU));
+                put(3, 0x80U | (cp & 0x3FU));
+                return 4;
+            }
+            else if constexpr(sizeof(CharT) == 2)
+            {
+                if(cp < 0x10000U)
+                {
+                    if(size < 1) return 0;
+                    put(0, cp);
+                    return 1;
+                }
+
+                if(size < 2) return 0;
+                put(0, 0xD800U + ((cp - 0x10000U) >> 10U));
+                put(1, 0xDC00U + ((cp - 0x10000U) & 0x3FFU));
+                return 2;
+            }
+            else
+            {
+                if(size < 1) return 0;
+                put(0, cp);
+                return 1;
+            }
+        }
+
+#if defined(__SSE2__)
+        // Blocks of input units converted at once when all of them are ASCII, or when none of
+        // them needs more than a change of width, like UTF-16 without surrogates to UTF-32.
+        // Returns false and writes nothing for the other blocks.
+
+        [[nodiscard]] inline __m128i utf_load(const void* const p) noexcept
+        {
+            return _mm_loadu_si128(static_cast<const __m128i*>(p));
+        }
+
+        inline void utf_store(void* const p, const __m128i v) noexcept
+        {
+            _mm_storeu_si128(static_cast<__m128i*>(p), v);
+        }
+
+        // unsigned 32 bits a < b
+        [[nodiscard]] inline __m128i utf_less_u32(const __m128i a, const ::std::uint32_t b) noexcept
+        {
+            const auto sign = _mm_set1_epi32(static_cast<int>(0x8000'0000U));
+
+            return _mm_cmplt_epi32(
+                _mm_xor_si128(a, sign),
+                _mm_xor_si128(_mm_set1_epi32(static_cast<int>(b)), sign)
+            );
+        }
+
+    #if defined(__AVX2__)
+        template<typename From>
+        inline constexpr ::std::size_t utf_block_size = sizeof(From) == 1 ? 32 : 16;
+
+        template<typename From, typename To>
+            requires(sizeof(From) == 1)
+        [[nodiscard]] bool utf_block(const From* const in, To* const out) noexcept
+        {
+            const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)); // NOLINT
+
+            if(_mm256_movemask_epi8(bytes) != 0) return false;
+
+            if constexpr(sizeof(To) == 1)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes); // NOLINT
+            else if constexpr(sizeof(To) == 2)
+                for(::std::size_t i = 0; i < 32; i += 16)
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i), // NOLINT
+                        _mm256_cvtepu8_epi16(utf_load(in + i))
+                    );
+            else
+                for(::std::size_t i = 0; i < 32; i += 8)
+                    _mm256_storeu_si256(
+                        reinterpret_cast<__m256i*>(out + i), // NOLINT
+                        _mm256_cvtepu8_epi32(
+                            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)) // NOLINT
+                        )
+                    );
+
+            return true;
+        }
+    #else
+        template<typename>
+        inline constexpr ::std::size_t utf_block_size = 16;
+
+        template<typename From, typename To>
+            requires(sizeof(From) == 1)
+        [[nodiscard]] bool utf_block(const From* const in, To* const out) noexcept
+        {
+            const auto bytes = utf_load(in);
+
+            if(_mm_movemask_epi8(bytes) != 0) return false;
+
+            if constexpr(sizeof(To) == 1) utf_store(out, bytes);
+            else
+            {
+                const auto zero = _mm_setzero_si128();
+                const auto low = _mm_unpacklo_epi8(bytes, zero);
+                const auto high = _mm_unpackhi_epi8(bytes, zero);
+
+                if constexpr(sizeof(To) == 2)
+                {
+                    utf_store(out, low);
+                    utf_store(out + 8, high);
+                }
+                else
+                {
+                    utf_store(out, _mm_unpacklo_epi16(low, zero));
+                    utf_store(out + 4, _mm_unpackhi_epi16(low, zero));
+                    utf_store(out + 8, _mm_unpacklo_epi16(high, zero));
+                    utf_store(out + 12, _mm_unpackhi_epi16(high, zero));
+                }
+            }
+
+            return true;
+        }
+    #endif
+
+        template<typename From, typename To>
+            requires(sizeof(From) == 2)
+        [[nodiscard]] bool utf_block(const From* const in, To* const out) noexcept
+        {
+            const auto a = utf_load(in);
+            const auto b = utf_load(in + 8);
+            const auto zero = _mm_setzero_si128();
+
+            if constexpr(sizeof(To) == 1)
+            {
+                const auto non_ascii =
+                    _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(static_cast<short>(0xFF80)));
+
+                if(_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, zero)) != 0xFFFF) return false;
+
+                utf_store(out, _mm_packus_epi16(a, b));
+            }
+            else
+            {
+                const auto mask = _mm_set1_epi16(static_cast<short>(0xF800));
+                const auto surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+                const auto surrogates = _mm_or_si128(
+                    _mm_cmpeq_epi16(_mm_and_si128(a, mask), surrogate),
+                    _mm_cmpeq_epi16(_mm_and_si128(b, mask), surrogate)
+                );
+
+                if(_mm_movemask_epi8(surrogates) != 0) return false;
+
+                if constexpr(sizeof(To) == 2)
+                {
+                    utf_store(out, a);
+                    utf_store(out + 8, b);
+                }
+                else
+                {
+                    utf_store(out, _mm_unpacklo_epi16(a, zero));
+                    utf_store(out + 4, _mm_unpackhi_epi16(a, zero));
+                    utf_store(out + 8, _mm_unpacklo_epi16(b, zero));
+                    utf_store(out + 12, _mm_unpackhi_epi16(b, zero));
+                }
+            }
+
+            return true;
+        }
+
+        template<typename From, typename To>
+            requires(sizeof(From) == 4)
+        [[nodiscard]] bool utf_block(const From* const in, To* const out) noexcept
+        {
+            // NOLINTNEXTLINE(*-avoid-c-arrays)
+            const __m128i v[]{utf_load(in), utf_load(in + 4), utf_load(in + 8), utf_load(in + 12)};
+            auto valid = _mm_set1_epi32(-1);
+
+            for(const auto u : v)
+                if constexpr(sizeof(To) == 1) valid = _mm_and_si128(valid, utf_less_u32(u, 0x80));
+                else
+                {
+                    const auto surrogate =
+                        utf_less_u32(_mm_sub_epi32(u, _mm_set1_epi32(0xD800)), 0x800);
+
+                    valid = _mm_and_si128(
+                        valid,
+                        _mm_andnot_si128(
+                            surrogate,
+                            utf_less_u32(u, sizeof(To) == 2 ? 0x10000 : 0x110000)
+                        )
+                    );
+                }
+
+            if(_mm_movemask_epi8(valid) != 0xFFFF) return false;
+
+            if constexpr(sizeof(To) == 1)
+                utf_store(
+                    out,
+                    _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3]))
+                );
+            else if constexpr(sizeof(To) == 2)
+            {
+                // signed saturation keeps the units once they are moved into the int16 range
+                const auto bias32 = _mm_set1_epi32(0x8000);
+                const auto bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+                const auto pack = [&](const __m128i x, const __m128i y)
+                {
+                    return _mm_add_epi16(
+                        _mm_packs_epi32(_mm_sub_epi32(x, bias32), _mm_sub_epi32(y, bias32)),
+                        bias16
+                    );
+                };
+
+                utf_store(out, pack(v[0], v[1]));
+                utf_store(out + 8, pack(v[2], v[3]));
+            }
+            else
+                for(::std::size_t i = 0; i < 4; ++i) utf_store(out + i * 4, v[i]);
+
+            return true;
+        }
+#else
+        template<typename>
+        inline constexpr ::std::size_t utf_block_size = 16;
+#endif
+
+        template<typename From, typename To>
+        [[nodiscard]] transcode_result transcode_utf(
+            const From* const in,
+            const ::std::size_t in_size,
+            To* const out,
+            const ::std::size_t out_size
+        ) noexcept
+        {
+            constexpr auto block = utf_block_size<From>;
+
+            ::std::size_t read = 0;
+            ::std::size_t written = 0;
+
+            while(read < in_size)
+            {
+#if defined(__SSE2__)
+                while(in_size - read >= block && out_size - written >= block &&
+                      utf_block(in + read, out + written))
+                {
+                    read += block;
+                    written += block;
+                }
+#endif
+
+                // the rest of a block that the kernel rejected is decoded one by one
+                for(const auto end = ::std::min(in_size, read + block); read < end;)
+                {
+                    const auto [cp, length] = decode_utf(in + read, in_size - read);
+
+                    if(length == 0) return {read, written, ::std::errc::illegal_byte_sequence};
+
+                    const auto count = encode_utf(cp, out + written, out_size - written);
+
+                    if(count == 0) return {read, written, ::std::errc::value_too_large};
+
+                    read += length;
+                    written += count;
+                }
+            }
+
+            return {read, written, {}};
+        }
+    }
+
+    // converts between UTF-8, UTF-16 and UTF-32, stopping at the first invalid character
+    template<utf_char To>
+    struct transcode_fn
+    {
+        template<utf_string Str>
+        transcode_result operator()(const Str& str, const ::std::span<To> out) const noexcept
+        {
+            const ::std::basic_string_view in{str};
+
+            return details::transcode_utf(in.data(), in.size(), out.data(), out.size());
+        }
+
+        template<utf_string Str>
+        [[nodiscard]] ::std::basic_string<To> operator()(const Str& str) const
+        {
+            using from = typename details::utf_string_view_t<Str>::value_type;
+
+            const ::std::basic_string_view in{str};
+            ::std::basic_string<To> out;
+            transcode_result result{};
+
+            out.resize_and_overwrite(
+                in.size() * details::utf_max_expansion<from, To>,
+                [&](To* const data, const ::std::size_t size) noexcept
+                {
+                    result = details::transcode_utf(in.data(), in.size(), data, size);
+                    return result.written;
+                }
+            );
+
+            if(result.ec != ::std::errc{})
+                throw ::std::runtime_error{
+                    "invalid character at " + ::std::to_string(result.read) //
+                };
+
+            return out;
+        }
+    };
+
+    template<utf_char To>
+    inline constexpr transcode_fn<To> transcode{};
+}
\ No newline at end of file
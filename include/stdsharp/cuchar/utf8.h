@@ -0,0 +1,493 @@
+#pragma once
+
+#include <array>
+
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+#endif
+
+#include "utf.h"
+
+namespace stdsharp
+{
+    // UTF-8 strings of char or char8_t
+    template<typename Str>
+    concept utf8_string =
+        utf_string<Str> && sizeof(typename details::utf_string_view_t<Str>::value_type) == 1;
+
+    struct utf8_count
+    {
+        // lead bytes, the characters of valid text
+        ::std::size_t code_points;
+
+        // '\n' bytes, like wc -l
+        ::std::size_t lines;
+    };
+
+    namespace details
+    {
+        [[nodiscard]] inline ::std::size_t valid_utf8_prefix_scalar(
+            const ::std::uint8_t* const in,
+            const ::std::size_t size
+        ) noexcept
+        {
+            ::std::size_t i = 0;
+
+            while(i < size)
+            {
+#if defined(__SSE2__)
+                // ASCII runs are skipped 16 bytes at a time
+                while(size - i >= 16 && in[i] < 0x80 &&
+                      _mm_movemask_epi8(_mm_loadu_si128(
+                          reinterpret_cast<const __m128i*>(in + i) // NOLINT
+                      )) == 0)
+                    i += 16;
+
+                if(i == size) break;
+#endif
+
+                const auto [_, length] = decode_utf(in + i, size - i);
+
+                if(length == 0) return i;
+
+                i += length;
+            }
+
+            return size;
+        }
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+    #if defined(__AVX2__)
+        struct utf8_simd
+        {
+            using vec = __m256i;
+
+            static constexpr ::std::size_t width = 32;
+
+            [[nodiscard]] static vec load(const void* const p) noexcept
+            {
+                return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+            }
+
+            [[nodiscard]] static vec set1(const ::std::uint8_t v) noexcept
+            {
+                return _mm256_set1_epi8(static_cast<char>(v));
+            }
+
+            [[nodiscard]] static vec zero() noexcept { return _mm256_setzero_si256(); }
+
+            [[nodiscard]] static vec table(const ::std::array<::std::uint8_t, 16>& t) noexcept
+            {
+                return _mm256_broadcastsi128_si256(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.data())) // NOLINT
+                );
+            }
+
+            [[nodiscard]] static vec lookup(const vec table, const vec index) noexcept
+            {
+                return _mm256_shuffle_epi8(table, index);
+            }
+
+            [[nodiscard]] static vec high_nibbles(const vec v) noexcept
+            {
+                return _mm256_and_si256(_mm256_srli_epi16(v, 4), set1(0x0F));
+            }
+
+            [[nodiscard]] static vec low_nibbles(const vec v) noexcept
+            {
+                return _mm256_and_si256(v, set1(0x0F));
+            }
+
+            // the input shifted by N bytes, with the end of the previous block shifted in
+            template<int N>
+            [[nodiscard]] static vec prev(const vec input, const vec previous) noexcept
+            {
+                return _mm256_alignr_epi8(
+                    input,
+                    _mm256_permute2x128_si256(previous, input, 0x21),
+                    16 - N
+                );
+            }
+
+            [[nodiscard]] static vec subs(const vec a, const vec b) noexcept
+            {
+                return _mm256_subs_epu8(a, b);
+            }
+
+            [[nodiscard]] static vec and_(const vec a, const vec b) noexcept
+            {
+                return _mm256_and_si256(a, b);
+            }
+
+            [[nodiscard]] static vec or_(const vec a, const vec b) noexcept
+            {
+                return _mm256_or_si256(a, b);
+            }
+
+            [[nodiscard]] static vec xor_(const vec a, const vec b) noexcept
+            {
+                return _mm256_xor_si256(a, b);
+            }
+
+            [[nodiscard]] static bool ascii(const vec v) noexcept
+            {
+                return _mm256_movemask_epi8(v) == 0;
+            }
+
+            [[nodiscard]] static bool any(const vec v) noexcept
+            {
+                return _mm256_testz_si256(v, v) == 0;
+            }
+        };
+    #else
+        struct utf8_simd
+        {
+            using vec = __m128i;
+
+            static constexpr ::std::size_t width = 16;
+
+            [[nodiscard]] static vec load(const void* const p) noexcept
+            {
+                return _mm_loadu_si128(static_cast<const __m128i*>(p));
+            }
+
+            [[nodiscard]] static vec set1(const ::std::uint8_t v) noexcept
+            {
+                return _mm_set1_epi8(static_cast<char>(v));
+            }
+
+            [[nodiscard]] static vec zero() noexcept { return _mm_setzero_si128(); }
+
+            [[nodiscard]] static vec table(const ::std::array<::std::uint8_t, 16>& t) noexcept
+            {
+                return load(t.data());
+            }
+
+            [[nodiscard]] static vec lookup(const vec table, const vec index) noexcept
+            {
+                return _mm_shuffle_epi8(table, index);
+            }
+
+            [[nodiscard]] static vec high_nibbles(const vec v) noexcept
+            {
+                return _mm_and_si128(_mm_srli_epi16(v, 4), set1(0x0F));
+            }
+
+            [[nodiscard]] static vec low_nibbles(const vec v) noexcept
+            {
+                return _mm_and_si128(v, set1(0x0F));
+            }
+
+            template<int N>
+            [[nodiscard]] static vec prev(const vec input, const vec previous) noexcept
+            {
+                return _mm_alignr_epi8(input, previous, 16 - N);
+            }
+
+            [[nodiscard]] static vec subs(const vec a, const vec b) noexcept
+            {
+                return _mm_subs_epu8(a, b);
+            }
+
+            [[nodiscard]] static vec and_(const vec a, const vec b) noexcept
+            {
+                return _mm_and_si128(a, b);
+            }
+
+            [[nodiscard]] static vec or_(const vec a, const vec b) noexcept
+            {
+                return _mm_or_si128(a, b);
+            }
+
+            [[nodiscard]] static vec xor_(const vec a, const vec b) noexcept
+            {
+                return _mm_xor_si128(a, b);
+            }
+
+            [[nodiscard]] static bool ascii(const vec v) noexcept
+            {
+                return _mm_movemask_epi8(v) == 0;
+            }
+
+            [[nodiscard]] static bool any(const vec v) noexcept
+            {
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero())) != 0xFFFF;
+            }
+        };
+    #endif
+
+        // Keiser and Lemire lookup validation, the high and low nibbles of each byte and the
+        // high nibble of the next one index three tables whose bits flag an error class, a byte
+        // pair is invalid when all three agree on a class
+        class utf8_lookup_validator
+        {
+            using simd = utf8_simd;
+            using vec = simd::vec;
+
+            static constexpr ::std::uint8_t too_short = 1 << 0;
+            static constexpr ::std::uint8_t too_long = 1 << 1;
+            static constexpr ::std::uint8_t overlong_3 = 1 << 2;
+            static constexpr ::std::uint8_t too_large = 1 << 3;
+            static constexpr ::std::uint8_t surrogate = 1 << 4;
+            static constexpr ::std::uint8_t overlong_2 = 1 << 5;
+            static constexpr ::std::uint8_t too_large_1000 = 1 << 6;
+            static constexpr ::std::uint8_t overlong_4 = 1 << 6;
+            static constexpr ::std::uint8_t two_conts = 1 << 7;
+            static constexpr ::std::uint8_t carry = too_short | too_long | two_conts;
+
+            static constexpr ::std::array<::std::uint8_t, 16> byte_1_high_table{
+                too_long,
+                too_long,
+                too_long,
+                too_long,
+                too_long,
+                too_long,
+                too_long,
+                too_long,
+                two_conts,
+                two_conts,
+                two_conts,
+                two_conts,
+                too_short | overlong_2,
+                too_short,
+                too_short | overlong_3 | surrogate,
+                too_short | too_large | too_large_1000 | overlong_4 //
+            };
+
+            static constexpr ::std::array<::std::uint8_t, 16> byte_1_low_table{
+                carry | overlong_3 | overlong_2 | overlong_4,
+                carry | overlong_2,
+                carry,
+                carry,
+                carry | too_large,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000 | surrogate,
+                carry | too_large | too_large_1000,
+                carry | too_large | too_large_1000 //
+            };
+
+            static constexpr ::std::array<::std::uint8_t, 16> byte_2_high_table{
+                too_short,
+                too_short,
+                too_short,
+                too_short,
+                too_short,
+                too_short,
+                too_short,
+                too_short,
+                too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+                too_long | overlong_2 | two_conts | overlong_3 | too_large,
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_long | overlong_2 | two_conts | surrogate | too_large,
+                too_short,
+                too_short,
+                too_short,
+                too_short //
+            };
+
+            // the last bytes of a block may only be leads of characters that fit in it
+            static constexpr auto incomplete_table = []
+            {
+                ::std::array<::std::uint8_t, simd::width> table{};
+
+                table.fill(0xFF);
+                table[simd::width - 3] = 0b1111'0000 - 1;
+                table[simd::width - 2] = 0b1110'0000 - 1;
+                table[simd::width - 1] = 0b1100'0000 - 1;
+
+                return table;
+            }();
+
+            vec byte_1_high_ = simd::table(byte_1_high_table);
+            vec byte_1_low_ = simd::table(byte_1_low_table);
+            vec byte_2_high_ = simd::table(byte_2_high_table);
+            vec incomplete_max_ = simd::load(incomplete_table.data());
+
+            vec error_ = simd::zero();
+            vec prev_input_ = simd::zero();
+            vec prev_incomplete_ = simd::zero();
+
+        public:
+            static constexpr auto width = simd::width;
+
+            void check(const vec input) noexcept
+            {
+                if(simd::ascii(input))
+                {
+                    error_ = simd::or_(error_, prev_incomplete_);
+                    prev_input_ = input;
+                    prev_incomplete_ = simd::zero();
+                    return;
+                }
+
+                const auto prev1 = simd::prev<1>(input, prev_input_);
+                const auto special = simd::and_(
+                    simd::and_(
+                        simd::lookup(byte_1_high_, simd::high_nibbles(prev1)),
+                        simd::lookup(byte_1_low_, simd::low_nibbles(prev1))
+                    ),
+                    simd::lookup(byte_2_high_, simd::high_nibbles(input))
+                );
+
+                // the third and fourth bytes must be continuations, which special flags as
+                // two_conts, so the expected ones cancel out
+                const auto third = simd::subs(
+                    simd::prev<2>(input, prev_input_),
+                    simd::set1(0b1110'0000 - 0x80)
+                );
+                const auto fourth = simd::subs(
+                    simd::prev<3>(input, prev_input_),
+                    simd::set1(0b1111'0000 - 0x80)
+                );
+                const auto must_be_continuation =
+                    simd::and_(simd::or_(third, fourth), simd::set1(0x80));
+
+                error_ = simd::or_(error_, simd::xor_(must_be_continuation, special));
+                prev_input_ = input;
+                prev_incomplete_ = simd::subs(input, incomplete_max_);
+            }
+
+            void check_eof() noexcept { error_ = simd::or_(error_, prev_incomplete_); }
+
+            [[nodiscard]] bool errors() const noexcept { return simd::any(error_); }
+        };
+#endif
+
+        [[nodiscard]] inline ::std::size_t
+            valid_utf8_prefix(const ::std::uint8_t* const in, const ::std::size_t size) noexcept
+        {
+#if defined(__AVX2__) || defined(__SSSE3__)
+            constexpr auto width = utf8_lookup_validator::width;
+
+            utf8_lookup_validator validator;
+            ::std::size_t i = 0;
+
+            for(; i + width <= size; i += width)
+            {
+                validator.check(utf8_simd::load(in + i));
+
+                // the error is in this block or at the end of the previous one
+                if(validator.errors()) break;
+            }
+
+            if(i + width > size)
+            {
+                ::std::array<::std::uint8_t, width> tail{};
+
+                ::std::ranges::copy(in + i, in + size, tail.begin());
+                validator.check(utf8_simd::load(tail.data()));
+                validator.check_eof();
+
+                if(!validator.errors()) return size;
+            }
+
+            auto start = i < width ? 0 : i - width;
+            while(start > 0 && is_utf8_continuation(in[start])) --start;
+
+            return start + valid_utf8_prefix_scalar(in + start, size - start);
+#else
+            return valid_utf8_prefix_scalar(in, size);
+#endif
+        }
+
+        [[nodiscard]] inline utf8_count
+            count_utf8(const ::std::uint8_t* const in, const ::std::size_t size) noexcept
+        {
+            utf8_count count{0, 0};
+            ::std::size_t i = 0;
+
+#if defined(__SSE2__)
+            // byte counters are summed before they can overflow
+            while(size - i >= 16)
+            {
+                const auto blocks = ::std::min<::std::size_t>((size - i) / 16, 255);
+                auto code_points = _mm_setzero_si128();
+                auto lines = _mm_setzero_si128();
+
+                for(::std::size_t b = 0; b < blocks; ++b, i += 16)
+                {
+                    const auto bytes =
+                        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)); // NOLINT
+
+                    // signed bytes above 0xBF are ASCII or leads
+                    code_points = _mm_sub_epi8(
+                        code_points,
+                        _mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(0xBF)))
+                    );
+                    lines = _mm_sub_epi8(lines, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+                }
+
+                const auto sum = [](const __m128i counters) noexcept
+                {
+                    const auto sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+
+                    return static_cast<::std::size_t>(
+                        _mm_cvtsi128_si64(sums) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums))
+                    );
+                };
+
+                count.code_points += sum(code_points);
+                count.lines += sum(lines);
+            }
+#endif
+
+            for(; i < size; ++i)
+            {
+                if(!is_utf8_continuation(in[i])) ++count.code_points;
+                if(in[i] == '\n') ++count.lines;
+            }
+
+            return count;
+        }
+
+        template<typename Str>
+        [[nodiscard]] auto utf8_bytes(const Str& str) noexcept
+        {
+            const ::std::basic_string_view view{str};
+
+            return ::std::pair{
+                reinterpret_cast<const ::std::uint8_t*>(view.data()), // NOLINT
+                view.size() //
+            };
+        }
+    }
+
+    // length of the longest valid UTF-8 prefix, the offset of the first invalid character
+    inline constexpr struct valid_utf8_prefix_fn
+    {
+        template<utf8_string Str>
+        [[nodiscard]] ::std::size_t operator()(const Str& str) const noexcept
+        {
+            const auto [data, size] = details::utf8_bytes(str);
+            return details::valid_utf8_prefix(data, size);
+        }
+    } valid_utf8_prefix{};
+
+    inline constexpr struct is_valid_utf8_fn
+    {
+        template<utf8_string Str>
+        [[nodiscard]] bool operator()(const Str& str) const noexcept
+        {
+            const auto [data, size] = details::utf8_bytes(str);
+            return details::valid_utf8_prefix(data, size) == size;
+        }
+    } is_valid_utf8{};
+
+    // counts lead bytes and line breaks without validating
+    inline constexpr struct count_utf8_fn
+    {
+        template<utf8_string Str>
+        [[nodiscard]] utf8_count operator()(const Str& str) const noexcept
+        {
+            const auto [data, size] = details::utf8_bytes(str);
+            return details::count_utf8(data, size);
+        }
+    } count_utf8{};
+}
\ No newline at end of file
@@ -0,0 +1,474 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include "../mutex/spin_mutex.h"
+#include "filesystem.h"
+
+#if __has_include(<dirent.h>) && __has_include(<fcntl.h>)
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define STDSHARP_HAS_OPENAT true
+#else
+    #define STDSHARP_HAS_OPENAT false
+#endif
+
+namespace stdsharp::filesystem
+{
+    struct space_usage
+    {
+        // sizes reported by the entries
+        bytes apparent_size{};
+
+        // blocks allocated on the disk, equals the apparent size where blocks are unknown
+        bytes allocated_size{};
+
+        ::std::uintmax_t files = 0;
+        ::std::uintmax_t directories = 0;
+
+        constexpr space_usage& operator+=(const space_usage& other) noexcept
+        {
+            apparent_size += other.apparent_size;
+            allocated_size += other.allocated_size;
+            files += other.files;
+            directories += other.directories;
+            return *this;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const space_usage&) const noexcept = default;
+    };
+
+    struct directory_usage_options
+    {
+        ::std::size_t thread_count = ::std::max(::std::thread::hardware_concurrency(), 1U);
+
+        // directories deeper than this aren't entered, the root is at depth 0
+        ::std::size_t max_depth = ::std::numeric_limits<::std::size_t>::max();
+
+        // directories down to this depth get their own total in the result
+        ::std::size_t breakdown_depth = 0;
+    };
+
+    struct directory_usage_result
+    {
+        using subtree_usage = ::std::pair<::std::filesystem::path, space_usage>;
+
+        // the root directory and everything under it
+        space_usage total;
+
+        // entries that couldn't be opened or stat'ed
+        ::std::uintmax_t skipped = 0;
+
+        // totals of the directories down to the breakdown depth, sorted by path
+        ::std::vector<subtree_usage> subtrees;
+    };
+
+    namespace details
+    {
+        struct directory_entry_info
+        {
+            ::std::uintmax_t apparent_size = 0;
+            ::std::uintmax_t allocated_size = 0;
+
+            // nanoseconds since the unix epoch
+            ::std::int64_t mtime = 0;
+
+            bool is_directory = false;
+
+            constexpr void add_to(space_usage& usage) const noexcept
+            {
+                usage.apparent_size += bytes{apparent_size};
+                usage.allocated_size += bytes{allocated_size};
+                ++(is_directory ? usage.directories : usage.files);
+            }
+        };
+
+#if STDSHARP_HAS_OPENAT
+        // stat block counts are in units of 512 bytes
+        [[nodiscard]] inline directory_entry_info to_entry_info(const struct ::stat& stat_buf
+        ) noexcept
+        {
+            constexpr ::std::int64_t nano = 1'000'000'000;
+
+            return {
+                .apparent_size = static_cast<::std::uintmax_t>(stat_buf.st_size),
+                .allocated_size = static_cast<::std::uintmax_t>(stat_buf.st_blocks) * 512,
+                .mtime = stat_buf.st_mtim.tv_sec * nano + stat_buf.st_mtim.tv_nsec,
+                .is_directory = S_ISDIR(stat_buf.st_mode) //
+            };
+        }
+
+        // follows symbolic links
+        [[nodiscard]] inline directory_entry_info
+            stat_entry(const ::std::filesystem::path& path, ::std::error_code& ec) noexcept
+        {
+            struct ::stat stat_buf
+            {
+            };
+
+            if(::stat(path.c_str(), &stat_buf) == -1)
+            {
+                ec.assign(errno, ::std::system_category());
+                return {};
+            }
+
+            ec.clear();
+            return to_entry_info(stat_buf);
+        }
+
+        // Invokes func with the name and the info of every entry of the directory, the entries
+        // are stat'ed relative to the directory descriptor without following symbolic links.
+        // Returns false if the directory can't be read.
+        template<typename Func>
+        bool for_each_entry(
+            const ::std::filesystem::path& dir,
+            Func func,
+            ::std::uintmax_t& skipped //
+        )
+        {
+            // NOLINTNEXTLINE(*-vararg)
+            const auto fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if(fd == -1) return false;
+
+            auto* const dir_stream = ::fdopendir(fd);
+            if(dir_stream == nullptr)
+            {
+                ::close(fd);
+                return false;
+            }
+
+            while(const auto* const entry = ::readdir(dir_stream))
+            {
+                const ::std::string_view name = entry->d_name;
+                if(name == "." || name == "..") continue;
+
+                struct ::stat stat_buf
+                {
+                };
+
+                if(::fstatat(fd, entry->d_name, &stat_buf, AT_SYMLINK_NOFOLLOW) == -1)
+                {
+                    ++skipped;
+                    continue;
+                }
+
+                func(name, to_entry_info(stat_buf));
+            }
+
+            ::closedir(dir_stream);
+            return true;
+        }
+#else
+        [[nodiscard]] inline ::std::int64_t
+            to_mtime(const ::std::filesystem::file_time_type time) noexcept
+        {
+            return ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
+                       ::std::chrono::file_clock::to_sys(time).time_since_epoch()
+            )
+                .count();
+        }
+
+        [[nodiscard]] inline directory_entry_info
+            stat_entry(const ::std::filesystem::path& path, ::std::error_code& ec) noexcept
+        {
+            const auto status = ::std::filesystem::status(path, ec);
+            if(ec) return {};
+
+            directory_entry_info info{.is_directory = ::std::filesystem::is_directory(status)};
+
+            if(::std::filesystem::is_regular_file(status))
+                info.apparent_size = info.allocated_size = ::std::filesystem::file_size(path, ec);
+
+            if(!ec) info.mtime = to_mtime(::std::filesystem::last_write_time(path, ec));
+
+            return info;
+        }
+
+        template<typename Func>
+        bool for_each_entry(
+            const ::std::filesystem::path& dir,
+            Func func,
+            ::std::uintmax_t& skipped //
+        )
+        {
+            ::std::error_code ec;
+            ::std::filesystem::directory_iterator it{dir, ec};
+
+            if(ec) return false;
+
+            for(const ::std::filesystem::directory_iterator end; !ec && it != end;
+                it.increment(ec))
+            {
+                const auto status = it->symlink_status(ec);
+                directory_entry_info info{.is_directory = ::std::filesystem::is_directory(status)};
+
+                if(!ec && ::std::filesystem::is_regular_file(status))
+                    info.apparent_size = info.allocated_size = it->file_size(ec);
+
+                if(!ec) info.mtime = to_mtime(it->last_write_time(ec));
+
+                if(ec)
+                {
+                    ++skipped;
+                    ec.clear();
+                    continue;
+                }
+
+                func(it->path().filename().string(), info);
+            }
+
+            if(ec) ++skipped;
+
+            return true;
+        }
+#endif
+
+        // Every directory is a task. Workers push the subdirectories they find to the back of
+        // their own deque and take from it in LIFO order, idle workers steal from the front of
+        // the others. Symbolic links aren't followed and hard links are counted per link.
+        class directory_usage_scanner
+        {
+            struct task
+            {
+                ::std::filesystem::path path;
+                ::std::size_t depth;
+                ::std::size_t subtree;
+            };
+
+            struct subtree
+            {
+                ::std::filesystem::path path;
+                ::std::size_t parent;
+            };
+
+            struct worker
+            {
+                spin_mutex mutex;
+                ::std::deque<task> tasks;
+                ::std::vector<space_usage> usages;
+                ::std::uintmax_t skipped = 0;
+            };
+
+            const directory_usage_options& options_;
+            ::std::deque<worker> workers_;
+
+            ::std::mutex subtrees_mutex_;
+            ::std::deque<subtree> subtrees_;
+
+            ::std::atomic_size_t pending_{0};
+            ::std::atomic<::std::uint32_t> queued_{0};
+
+            void push(worker& w, task t)
+            {
+                pending_.fetch_add(1, ::std::memory_order_relaxed);
+
+                {
+                    const ::std::scoped_lock lock{w.mutex};
+                    w.tasks.push_back(::std::move(t));
+                }
+
+                queued_.fetch_add(1, ::std::memory_order_release);
+                queued_.notify_one();
+            }
+
+            [[nodiscard]] ::std::optional<task> take(worker& self)
+            {
+                {
+                    const ::std::scoped_lock lock{self.mutex};
+
+                    if(!self.tasks.empty())
+                    {
+                        auto t = ::std::move(self.tasks.back());
+                        self.tasks.pop_back();
+                        return t;
+                    }
+                }
+
+                for(auto& victim : workers_)
+                {
+                    if(&victim == &self) continue;
+
+                    const ::std::scoped_lock lock{victim.mutex};
+
+                    if(!victim.tasks.empty())
+                    {
+                        auto t = ::std::move(victim.tasks.front());
+                        victim.tasks.pop_front();
+                        return t;
+                    }
+                }
+
+                return ::std::nullopt;
+            }
+
+            [[nodiscard]] ::std::size_t
+                subtree_of(const task& parent, const ::std::filesystem::path& path)
+            {
+                if(parent.depth >= options_.breakdown_depth) return parent.subtree;
+
+                const ::std::scoped_lock lock{subtrees_mutex_};
+                subtrees_.push_back({path, parent.subtree});
+                return subtrees_.size() - 1;
+            }
+
+            // returns the subtree the directory itself is counted in
+            [[nodiscard]] ::std::size_t
+                on_directory(worker& w, const task& parent, ::std::filesystem::path path)
+            {
+                const auto index = subtree_of(parent, path);
+
+                if(parent.depth < options_.max_depth)
+                    push(w, {::std::move(path), parent.depth + 1, index});
+
+                return index;
+            }
+
+            [[nodiscard]] static space_usage& usage_of(worker& w, const ::std::size_t subtree)
+            {
+                if(w.usages.size() <= subtree) w.usages.resize(subtree + 1);
+                return w.usages[subtree];
+            }
+
+            void scan(worker& w, const task& t)
+            {
+                const auto opened = for_each_entry(
+                    t.path,
+                    [&](const ::std::string_view name, const directory_entry_info& info)
+                    {
+                        const auto subtree =
+                            info.is_directory ? on_directory(w, t, t.path / name) : t.subtree;
+
+                        info.add_to(usage_of(w, subtree));
+                    },
+                    w.skipped
+                );
+
+                if(!opened) ++w.skipped;
+            }
+
+            [[nodiscard]] static space_usage root_usage(const ::std::filesystem::path& root)
+            {
+                ::std::error_code ec;
+                const auto info = stat_entry(root, ec);
+
+                if(ec)
+                    throw ::std::filesystem::filesystem_error{
+                        "directory_usage stat failed",
+                        root,
+                        ec //
+                    };
+
+                space_usage usage;
+                info.add_to(usage);
+                return usage;
+            }
+
+            void run(worker& self)
+            {
+                for(exponential_backoff backoff;;)
+                {
+                    const auto seen = queued_.load(::std::memory_order_acquire);
+
+                    if(auto t = take(self))
+                    {
+                        scan(self, *t);
+
+                        // the last task wakes up the waiting workers to exit
+                        if(pending_.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+                        {
+                            queued_.fetch_add(1, ::std::memory_order_release);
+                            queued_.notify_all();
+                        }
+
+                        backoff.reset();
+                        continue;
+                    }
+
+                    if(pending_.load(::std::memory_order_acquire) == 0) return;
+
+                    if(backoff.spinning()) backoff();
+                    else queued_.wait(seen, ::std::memory_order_acquire);
+                }
+            }
+
+        public:
+            explicit directory_usage_scanner(const directory_usage_options& options):
+                options_(options), workers_(::std::max(options.thread_count, ::std::size_t{1}))
+            {
+            }
+
+            [[nodiscard]] directory_usage_result operator()(const ::std::filesystem::path& root)
+            {
+                directory_usage_result result;
+
+                result.total = root_usage(root);
+                if(result.total.directories == 0) return result;
+
+                subtrees_.push_back({root, 0});
+
+                push(workers_.front(), {root, 0, 0});
+
+                {
+                    ::std::vector<::std::jthread> threads;
+                    threads.reserve(workers_.size() - 1);
+
+                    for(auto& w : workers_ | ::std::views::drop(1))
+                        threads.emplace_back([this, &w] { run(w); });
+
+                    run(workers_.front());
+                }
+
+                ::std::vector<space_usage> usages(subtrees_.size());
+                usages.front() = result.total;
+
+                for(const auto& w : workers_)
+                {
+                    for(::std::size_t i = 0; i < w.usages.size(); ++i) usages[i] += w.usages[i];
+                    result.skipped += w.skipped;
+                }
+
+                // a subtree is always registered after its parent
+                for(auto i = subtrees_.size() - 1; i > 0; --i)
+                    usages[subtrees_[i].parent] += usages[i];
+
+                result.total = usages.front();
+                result.subtrees.reserve(subtrees_.size() - 1);
+
+                for(::std::size_t i = 1; i < subtrees_.size(); ++i)
+                    result.subtrees.emplace_back(::std::move(subtrees_[i].path), usages[i]);
+
+                ::std::ranges::sort(
+                    result.subtrees,
+                    {},
+                    &directory_usage_result::subtree_usage::first //
+                );
+
+                return result;
+            }
+        };
+    }
+
+    // Measures the space used by a directory tree with a pool of work stealing threads.
+    inline constexpr struct directory_usage_fn
+    {
+        [[nodiscard]] directory_usage_result operator()(
+            const ::std::filesystem::path& root,
+            const directory_usage_options& options = {} //
+        ) const
+        {
+            return details::directory_usage_scanner{options}(root);
+        }
+    } directory_usage{};
+}
+
+#undef STDSHARP_HAS_OPENAT
\ No newline at end of file
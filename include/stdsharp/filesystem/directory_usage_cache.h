@@ -0,0 +1,543 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../fstream/mapped_file.h"
+#include "directory_usage.h"
+
+#if __has_include(<sys/inotify.h>)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+
+    #define STDSHARP_HAS_INOTIFY true
+#else
+    #define STDSHARP_HAS_INOTIFY false
+#endif
+
+namespace stdsharp::filesystem
+{
+    // Usage index of a directory tree remembering the modification time and the usage of every
+    // directory. Adding, removing or renaming an entry touches the modification time of its
+    // directory, so a refresh stats every directory but only reads the changed ones. Files that
+    // change in place don't touch their directory, watch() subscribes the directories to inotify
+    // so that those are caught as well, and a refresh without events doesn't touch the disk.
+    class directory_usage_cache
+    {
+        static constexpr ::std::int64_t unscanned = ::std::numeric_limits<::std::int64_t>::min();
+
+        // a directory modified this close to its scan may change again within the same
+        // timestamp tick, it is read again on the next refresh
+        static constexpr ::std::int64_t racy_window = 2'000'000'000;
+
+        static constexpr ::std::array magic{'S', 'S', 'D', 'U'};
+        static constexpr ::std::uint32_t version = 1;
+
+        struct record
+        {
+            // the directory itself and its entries that aren't directories
+            space_usage own;
+
+            // own and every subdirectory
+            space_usage total;
+
+            // sorted names of the subdirectories
+            ::std::vector<::std::string> children;
+
+            ::std::int64_t mtime = unscanned;
+            int watch = -1;
+        };
+
+        ::std::filesystem::path root_;
+
+        // keyed by the generic path relative to the root, the root itself is the empty key
+        ::std::unordered_map<::std::string, record> records_;
+
+        ::std::size_t rescanned_ = 0;
+        ::std::int64_t refresh_time_ = 0;
+
+#if STDSHARP_HAS_INOTIFY
+        static constexpr ::std::uint32_t watch_mask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE |
+            IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO |
+            IN_ONLYDIR;
+
+        int inotify_ = -1;
+
+        // the owner of each watch, a directory moved within the tree keeps its watch
+        // descriptor and the record of the new path takes it over from the old one
+        ::std::unordered_map<int, ::std::string> watched_;
+        ::std::unordered_set<::std::string> dirty_;
+
+        // events were lost or a directory couldn't be watched, every refresh polls
+        bool polling_ = false;
+#endif
+
+        [[nodiscard]] ::std::filesystem::path path_of(const ::std::string& key) const
+        {
+            return key.empty() ? root_ : root_ / key;
+        }
+
+        [[nodiscard]] static ::std::string
+            child_key(const ::std::string& key, const ::std::string_view name)
+        {
+            return key.empty() ? ::std::string{name} : key + '/' + ::std::string{name};
+        }
+
+        [[nodiscard]] static ::std::string parent_key(const ::std::string& key)
+        {
+            const auto pos = key.rfind('/');
+            return pos == ::std::string::npos ? ::std::string{} : key.substr(0, pos);
+        }
+
+        [[nodiscard]] static ::std::size_t depth_of(const ::std::string& key) noexcept
+        {
+            return key.empty() ? 0 : static_cast<::std::size_t>(::std::ranges::count(key, '/')) + 1;
+        }
+
+        void add_watch([[maybe_unused]] const ::std::string& key, [[maybe_unused]] record& rec)
+        {
+#if STDSHARP_HAS_INOTIFY
+            if(inotify_ == -1 || rec.watch != -1) return;
+
+            rec.watch = ::inotify_add_watch(inotify_, path_of(key).c_str(), watch_mask);
+
+            if(rec.watch == -1)
+            {
+                polling_ = true;
+                return;
+            }
+
+            if(const auto it = watched_.find(rec.watch); it != watched_.end())
+                if(const auto owner = records_.find(it->second);
+                   owner != records_.end() && &owner->second != &rec)
+                    owner->second.watch = -1;
+
+            watched_[rec.watch] = key;
+#endif
+        }
+
+        // the watch is left alone if another record took it over
+        void remove_watch([[maybe_unused]] const ::std::string& key, record& rec) noexcept
+        {
+#if STDSHARP_HAS_INOTIFY
+            if(rec.watch == -1) return;
+
+            if(const auto it = watched_.find(rec.watch); it != watched_.end() && it->second == key)
+            {
+                ::inotify_rm_watch(inotify_, rec.watch);
+                watched_.erase(it);
+            }
+#endif
+            rec.watch = -1;
+        }
+
+        void erase(const ::std::string& key)
+        {
+            const auto it = records_.find(key);
+            if(it == records_.end()) return;
+
+            for(const auto& child : it->second.children) erase(child_key(key, child));
+
+            remove_watch(key, it->second);
+            records_.erase(it);
+        }
+
+        // reads the entries of the directory, returns the subdirectories that weren't known
+        ::std::vector<::std::string>
+            rescan(const ::std::string& key, record& rec, const details::directory_entry_info& info)
+        {
+            ++rescanned_;
+
+            space_usage own;
+            ::std::vector<::std::string> children;
+            ::std::uintmax_t skipped = 0;
+
+            info.add_to(own);
+            details::for_each_entry(
+                path_of(key),
+                [&](const ::std::string_view name, const details::directory_entry_info& entry)
+                {
+                    if(entry.is_directory) children.emplace_back(name);
+                    else entry.add_to(own);
+                },
+                skipped
+            );
+
+            ::std::ranges::sort(children);
+
+            ::std::vector<::std::string> added;
+            ::std::vector<::std::string> removed;
+
+            ::std::ranges::set_difference(children, rec.children, ::std::back_inserter(added));
+            ::std::ranges::set_difference(rec.children, children, ::std::back_inserter(removed));
+
+            for(const auto& name : removed) erase(child_key(key, name));
+
+            rec.own = own;
+            rec.children = ::std::move(children);
+            rec.mtime = info.mtime + racy_window > refresh_time_ ? unscanned : info.mtime;
+
+            add_watch(key, rec);
+
+            return added;
+        }
+
+        // brings the directory and every subdirectory up to date, returns its total
+        space_usage update(const ::std::string& key)
+        {
+            ::std::error_code ec;
+            const auto info = details::stat_entry(path_of(key), ec);
+
+            if(ec || !info.is_directory)
+            {
+                if(key.empty())
+                    throw ::std::filesystem::filesystem_error{
+                        "directory_usage_cache stat failed",
+                        root_,
+                        ec ? ec : ::std::make_error_code(::std::errc::not_a_directory) //
+                    };
+
+                erase(key);
+                return {};
+            }
+
+            auto& rec = records_[key];
+
+            if(rec.mtime == unscanned || rec.mtime != info.mtime) rescan(key, rec, info);
+
+            rec.total = rec.own;
+            for(const auto& child : rec.children) rec.total += update(child_key(key, child));
+
+            return rec.total;
+        }
+
+        void sum_children(record& rec, const ::std::string& key)
+        {
+            rec.total = rec.own;
+
+            for(const auto& child : rec.children)
+                if(const auto it = records_.find(child_key(key, child)); it != records_.end())
+                    rec.total += it->second.total;
+        }
+
+#if STDSHARP_HAS_INOTIFY
+        void read_events()
+        {
+            alignas(::inotify_event) ::std::array<char, 16 * 1024> buffer{};
+
+            while(true)
+            {
+                const auto read = ::read(inotify_, buffer.data(), buffer.size());
+                if(read <= 0) return;
+
+                for(::std::size_t offset = 0; offset < static_cast<::std::size_t>(read);)
+                {
+                    ::inotify_event event{};
+                    ::std::memcpy(&event, buffer.data() + offset, sizeof(event));
+                    offset += sizeof(event) + event.len;
+
+                    // the lost events may be files changed in place, which don't touch the
+                    // modification time of their directory, so every directory is read again
+                    if((event.mask & IN_Q_OVERFLOW) != 0)
+                    {
+                        for(auto& [key, rec] : records_) rec.mtime = unscanned;
+                        polling_ = true;
+                        continue;
+                    }
+
+                    const auto it = watched_.find(event.wd);
+                    if(it == watched_.end()) continue;
+
+                    // the kernel dropped the watch of a removed directory
+                    if((event.mask & IN_IGNORED) != 0)
+                    {
+                        if(const auto rec = records_.find(it->second); rec != records_.end())
+                            rec->second.watch = -1;
+
+                        watched_.erase(it);
+                        continue;
+                    }
+
+                    dirty_.insert(it->second);
+                }
+            }
+        }
+
+        // rescans the directories with events and sums the totals up to the root again
+        void update_dirty()
+        {
+            ::std::vector<::std::string> dirty{dirty_.begin(), dirty_.end()};
+            ::std::unordered_set<::std::string> affected;
+
+            dirty_.clear();
+
+            // parents first, so the subdirectories they removed aren't read
+            ::std::ranges::sort(dirty, {}, depth_of);
+
+            for(const auto& key : dirty)
+            {
+                const auto it = records_.find(key);
+                if(it == records_.end()) continue;
+
+                ::std::error_code ec;
+                const auto info = details::stat_entry(path_of(key), ec);
+
+                // removed directories are erased by the event of their parent
+                if(ec || !info.is_directory) continue;
+
+                for(const auto& name : rescan(key, it->second, info)) update(child_key(key, name));
+
+                for(auto k = key;; k = parent_key(k))
+                {
+                    if(!affected.insert(k).second || k.empty()) break;
+                }
+            }
+
+            ::std::vector<::std::string> keys{affected.begin(), affected.end()};
+
+            ::std::ranges::sort(keys, ::std::ranges::greater{}, depth_of);
+
+            for(const auto& key : keys)
+                if(const auto it = records_.find(key); it != records_.end())
+                    sum_children(it->second, key);
+        }
+#endif
+
+        [[nodiscard]] static ::std::int64_t now() noexcept
+        {
+            return ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
+                       ::std::chrono::system_clock::now().time_since_epoch()
+            )
+                .count();
+        }
+
+        template<typename T>
+        static void write(::std::string& buffer, const T& value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T)); // NOLINT
+        }
+
+        static void write(::std::string& buffer, const ::std::string_view str)
+        {
+            write(buffer, static_cast<::std::uint32_t>(str.size()));
+            buffer.append(str);
+        }
+
+        static void write(::std::string& buffer, const space_usage& usage)
+        {
+            write(buffer, usage.apparent_size.size());
+            write(buffer, usage.allocated_size.size());
+            write(buffer, usage.files);
+            write(buffer, usage.directories);
+        }
+
+        class reader
+        {
+            ::std::string_view data_;
+
+        public:
+            explicit reader(const ::std::string_view data) noexcept: data_(data) {}
+
+            template<typename T>
+            bool read(T& value) noexcept
+            {
+                if(data_.size() < sizeof(T)) return false;
+
+                ::std::memcpy(&value, data_.data(), sizeof(T));
+                data_.remove_prefix(sizeof(T));
+                return true;
+            }
+
+            bool read(::std::string& str)
+            {
+                ::std::uint32_t size = 0;
+                if(!read(size) || data_.size() < size) return false;
+
+                str.assign(data_.substr(0, size));
+                data_.remove_prefix(size);
+                return true;
+            }
+
+            bool read(space_usage& usage) noexcept
+            {
+                ::std::uintmax_t apparent = 0;
+                ::std::uintmax_t allocated = 0;
+
+                if(!read(apparent) || !read(allocated) || !read(usage.files) ||
+                   !read(usage.directories))
+                    return false;
+
+                usage.apparent_size = bytes{apparent};
+                usage.allocated_size = bytes{allocated};
+                return true;
+            }
+
+            [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
+        };
+
+        // an index of another root, version or machine is dropped
+        bool load(const ::std::string_view data)
+        {
+            reader r{data};
+            ::std::array<char, magic.size()> file_magic{};
+            ::std::uint32_t file_version = 0;
+            ::std::string root;
+            ::std::uint64_t count = 0;
+
+            if(!r.read(file_magic) || file_magic != magic || !r.read(file_version) ||
+               file_version != version || !r.read(root) || root != root_.generic_string() ||
+               !r.read(count))
+                return false;
+
+            for(::std::uint64_t i = 0; i < count; ++i)
+            {
+                ::std::string key;
+                record rec;
+
+                if(!r.read(key) || !r.read(rec.mtime) || !r.read(rec.own)) return false;
+
+                records_.emplace(::std::move(key), ::std::move(rec));
+            }
+
+            if(!r.empty() || !records_.contains({})) return false;
+
+            for(const auto& [key, rec] : records_)
+            {
+                if(key.empty()) continue;
+
+                const auto parent = records_.find(parent_key(key));
+                if(parent == records_.end()) return false;
+
+                parent->second.children.push_back(key.substr(key.rfind('/') + 1));
+            }
+
+            for(auto& [key, rec] : records_) ::std::ranges::sort(rec.children);
+
+            return true;
+        }
+
+    public:
+        explicit directory_usage_cache(::std::filesystem::path root): root_(::std::move(root)) {}
+
+        // starts from the index saved at the path if it is one of the same root
+        directory_usage_cache(::std::filesystem::path root, const ::std::filesystem::path& index):
+            directory_usage_cache(::std::move(root))
+        {
+            ::std::error_code ec;
+            if(!::std::filesystem::is_regular_file(index, ec)) return;
+
+            if(!load(mapped_file{index}.text())) records_.clear();
+        }
+
+        directory_usage_cache(const directory_usage_cache&) = delete;
+        directory_usage_cache(directory_usage_cache&&) = delete;
+        directory_usage_cache& operator=(const directory_usage_cache&) = delete;
+        directory_usage_cache& operator=(directory_usage_cache&&) = delete;
+
+        ~directory_usage_cache()
+        {
+#if STDSHARP_HAS_INOTIFY
+            if(inotify_ != -1) ::close(inotify_);
+#endif
+        }
+
+        [[nodiscard]] const auto& root() const noexcept { return root_; }
+
+        // Subscribes every directory to inotify and keeps new ones subscribed, returns false
+        // where inotify isn't available.
+        bool watch()
+        {
+#if STDSHARP_HAS_INOTIFY
+            if(inotify_ != -1) return true;
+
+            inotify_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if(inotify_ == -1) return false;
+
+            // directories changed before their watch was added are caught by polling once
+            for(auto& [key, rec] : records_) add_watch(key, rec);
+            polling_ = true;
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        // brings the index up to date and returns the total of the root
+        space_usage refresh()
+        {
+            rescanned_ = 0;
+            refresh_time_ = now();
+
+#if STDSHARP_HAS_INOTIFY
+            if(inotify_ != -1)
+            {
+                read_events();
+
+                if(!polling_)
+                {
+                    if(!dirty_.empty()) update_dirty();
+                    return total();
+                }
+
+                polling_ = false;
+                dirty_.clear();
+            }
+#endif
+
+            return update({});
+        }
+
+        // the total of the root as of the last refresh
+        [[nodiscard]] space_usage total() const
+        {
+            const auto it = records_.find({});
+            return it == records_.end() ? space_usage{} : it->second.total;
+        }
+
+        // directories read by the last refresh
+        [[nodiscard]] ::std::size_t rescanned_directories() const noexcept { return rescanned_; }
+
+        // Writes the index to a temporary file next to the path and renames it over the path,
+        // the index is only meant to be read back on the same machine.
+        void save(const ::std::filesystem::path& index) const
+        {
+            ::std::string buffer;
+
+            buffer.append(magic.data(), magic.size());
+            write(buffer, version);
+            write(buffer, ::std::string_view{root_.generic_string()});
+            write(buffer, static_cast<::std::uint64_t>(records_.size()));
+
+            for(const auto& [key, rec] : records_)
+            {
+                write(buffer, ::std::string_view{key});
+                write(buffer, rec.mtime);
+                write(buffer, rec.own);
+            }
+
+            auto temp = index;
+            temp += ".tmp";
+
+            {
+                ::std::ofstream fs{temp, ::std::ios::binary | ::std::ios::trunc};
+                fs.write(buffer.data(), static_cast<::std::streamsize>(buffer.size()));
+
+                if(!fs)
+                    throw ::std::filesystem::filesystem_error{
+                        "directory_usage_cache save failed",
+                        temp,
+                        ::std::make_error_code(::std::errc::io_error) //
+                    };
+            }
+
+            ::std::filesystem::rename(temp, index);
+        }
+    };
+}
+
+#undef STDSHARP_HAS_INOTIFY
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <charconv>
+#include <cmath>
 #include <filesystem>
 #include <ratio>
+#include <sstream>
 
 #include "../format/format.h"
 #include "../default_operator.h"
@@ -30,14 +33,14 @@ namespace stdsharp::filesystem
         };
     }
 
-    template<typename Rep, ::std::uintmax_t Num, ::std::uintmax_t Denom>
+    template<typename Rep, ::std::intmax_t Num, ::std::intmax_t Denom>
         requires(!::std::same_as<::std::ratio<Num, Denom>, typename ::std::ratio<Num, Denom>::type>)
     class space_size<Rep, ::std::ratio<Num, Denom>> :
         public space_size<Rep, typename ::std::ratio<Num, Denom>::type>
     {
     };
 
-    template<typename Rep, ::std::uintmax_t Num, ::std::uintmax_t Denom>
+    template<typename Rep, ::std::intmax_t Num, ::std::intmax_t Denom>
     class space_size<Rep, ::std::ratio<Num, Denom>> :
         default_arithmetic_assign_operation<
             space_size<Rep, ::std::ratio<Num, Denom>>,
@@ -256,6 +259,30 @@ namespace stdsharp::filesystem
     #endif
 #endif
 
+    namespace details
+    {
+        // unit written by operator<<, empty for the periods it doesn't know
+        template<typename Period>
+        [[nodiscard]] consteval ::std::string_view space_size_unit() noexcept
+        {
+            if constexpr(::std::same_as<Period, bits::period>) return "b";
+            else if constexpr(::std::same_as<Period, bytes::period>) return "B";
+            else if constexpr(::std::same_as<Period, kilobytes::period>) return "KB";
+            else if constexpr(::std::same_as<Period, megabytes::period>) return "MB";
+            else if constexpr(::std::same_as<Period, gigabytes::period>) return "GB";
+            else if constexpr(::std::same_as<Period, terabytes::period>) return "TB";
+            else if constexpr(::std::same_as<Period, petabytes::period>) return "PB";
+            else if constexpr(::std::same_as<Period, exabytes::period>) return "EB";
+            else if constexpr(::std::same_as<Period, kibibytes::period>) return "KiB";
+            else if constexpr(::std::same_as<Period, mebibytes::period>) return "MiB";
+            else if constexpr(::std::same_as<Period, gibibytes::period>) return "GiB";
+            else if constexpr(::std::same_as<Period, tebibytes::period>) return "TiB";
+            else if constexpr(::std::same_as<Period, pebibytes::period>) return "PiB";
+            else if constexpr(::std::same_as<Period, exbibytes::period>) return "EiB";
+            else return {};
+        }
+    }
+
     template<typename CharT, typename Traits, typename Rep, typename Period>
         requires requires(std::basic_ostream<CharT, Traits> os, Rep rep)
         {
@@ -480,9 +507,324 @@ namespace fmt
 
         ::std::basic_string_view<CharT> from_unit_;
 
+        enum class human_readable : ::std::uint8_t
+        {
+            none,
+            binary,
+            decimal
+        };
+
+        human_readable human_readable_{};
+
         template<typename T>
         using identity = ::std::type_identity<T>;
 
+        template<typename OutputIt>
+        auto make_stream(basic_format_context<OutputIt, CharT>& fc) const
+        {
+            ::std::basic_ostringstream<CharT> ss;
+
+            if(locale_.use_locale)
+#if __cpp_lib_format >= 201907L
+                ss.imbue(fc.locale());
+#else
+                ss.imbue(fc.locale().template get<::std::locale>());
+#endif
+            else
+                ss.imbue(::std::locale::classic());
+
+            return ss;
+        }
+
+        template<typename Out, typename T>
+        static Out write_chars(Out out, const T value, const auto... args)
+        {
+            ::std::array<char, 128> buffer{};
+            const auto [ptr, ec] = ::std::to_chars(
+                buffer.data(),
+                buffer.data() + buffer.size(),
+                value,
+                args... //
+            );
+
+            if(ec != ::std::errc{}) throw format_error{"Precision exceeded"};
+
+            return ::std::ranges::copy(buffer.data(), ptr, out).out;
+        }
+
+        template<typename Emit, typename OutputIt>
+        void write_units(
+            const Emit& emit,
+            space_size s,
+            const basic_format_context<OutputIt, CharT>& fc //
+        ) const
+        {
+            const auto from_unit = [from_unit_ = from_unit_]
+            {
+                ::std::array<char, 4> from_unit{};
+
+                ::std::ranges::transform(
+                    from_unit_,
+                    from_unit.begin(),
+                    [](const CharT c) { return static_cast<char>(c); } //
+                );
+                return from_unit;
+            }();
+
+            ::std::string_view current_unit{
+                from_unit.begin(), //
+                ::std::ranges::find(from_unit, char{}) //
+            };
+
+            const auto do_format = [&current_unit, &emit, &s]
+            {
+                const auto format_case =
+                    [&]<typename SpaceSize>( // clang-format off
+                    const identity<SpaceSize>,
+                    const ::std::string_view next_unit
+                ) noexcept // clang-format on
+                {
+                    return [&, next_unit](const ::std::string_view)
+                    {
+                        const SpaceSize cast_size = s;
+
+                        emit(cast_size);
+
+                        s -= space_size{cast_size};
+                        current_unit = next_unit;
+                    };
+                };
+
+                ::stdsharp::pattern_match(
+                    current_unit,
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit.empty(); },
+                        [](const ::std::string_view)
+                        { throw format_error{"Precision exceeded"}; } //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "b"; },
+                        format_case(identity<::stdsharp::filesystem::bits>{}, "")
+                        //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "B"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::bytes>{},
+                            "b") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "KiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::kibibytes>{},
+                            "B") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "KB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::kilobytes>{},
+                            "B") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "MiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::mebibytes>{},
+                            "KiB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "MB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::megabytes>{},
+                            "KB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "GiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::gibibytes>{},
+                            "MiB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "GB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::gigabytes>{},
+                            "MB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "TiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::tebibytes>{},
+                            "GiB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "TB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::terabytes>{},
+                            "GB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "PiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::pebibytes>{},
+                            "TiB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "PB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::petabytes>{},
+                            "TB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "EiB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::exbibytes>{},
+                            "PiB") //
+                    },
+                    ::std::pair{
+                        //
+                        [](const ::std::string_view unit) noexcept { return unit == "EB"; },
+                        format_case(
+                            identity<::stdsharp::filesystem::exabytes>{},
+                            "PB") //
+                    } //
+                );
+            };
+
+            if(const auto precision = ::stdsharp::fmt::get_arg(fc, precision_.precision); precision)
+                for(auto i = *precision; i != 0; --i) do_format();
+            else
+                while(s.size() > 0)
+                {
+                    if(current_unit.empty())
+                    {
+                        emit(s);
+                        break;
+                    }
+
+                    do_format();
+                }
+        }
+
+        // the largest unit the value reaches, with the precision as fraction digits
+        template<typename Out, typename OutputIt>
+        Out write_human_readable(
+            Out out,
+            const space_size s,
+            basic_format_context<OutputIt, CharT>& fc //
+        ) const
+        {
+            static constexpr ::std::array<::std::string_view, 7> binary_units{
+                "B",
+                "KiB",
+                "MiB",
+                "GiB",
+                "TiB",
+                "PiB",
+                "EiB" //
+            };
+            static constexpr ::std::array<::std::string_view, 7> decimal_units{
+                "B",
+                "KB",
+                "MB",
+                "GB",
+                "TB",
+                "PB",
+                "EB" //
+            };
+
+            const auto binary = human_readable_ == human_readable::binary;
+            const auto& units = binary ? binary_units : decimal_units;
+            const long double base = binary ? 1024 : 1000;
+            auto value = static_cast<long double>(s.size()) * Period::num / Period::den;
+            ::std::size_t unit = 0;
+
+            for(; unit + 1 < units.size() && ::std::abs(value) >= base; ++unit) value /= base;
+
+            const auto precision = static_cast<int>(
+                ::stdsharp::fmt::get_arg(fc, precision_.precision).value_or(1) //
+            );
+
+            // bytes are whole, the other units take the precision as fraction digits
+            auto digits = unit == 0 ? 0 : precision;
+
+            // rounding may reach the base, 1023.96KiB is 1.0MiB with one digit
+            if(const auto scale = ::std::pow(10.0L, digits);
+               unit + 1 < units.size() && ::std::round(::std::abs(value) * scale) >= base * scale)
+            {
+                value /= base;
+                ++unit;
+                digits = precision;
+            }
+
+            if(locale_.use_locale)
+            {
+                auto ss = make_stream(fc);
+
+                ss.precision(digits);
+                ss << ::std::fixed << value;
+                out = ::std::ranges::copy(::std::move(ss).str(), out).out;
+            }
+            else
+                out = write_chars(out, value, ::std::chars_format::fixed, digits);
+
+            return ::std::ranges::copy(units[unit], out).out;
+        }
+
+        template<typename Out, typename OutputIt>
+        Out write(Out out, const space_size s, basic_format_context<OutputIt, CharT>& fc) const
+        {
+            if(human_readable_ != human_readable::none) return write_human_readable(out, s, fc);
+
+            // streams are only needed for the locale or for periods without a known unit
+            constexpr auto known_unit =
+                !::stdsharp::filesystem::details::space_size_unit<Period>().empty();
+
+            if(locale_.use_locale || !known_unit)
+            {
+                auto ss = make_stream(fc);
+
+                write_units([&ss](const auto size) { ss << size; }, s, fc);
+
+                return ::std::ranges::copy(::std::move(ss).str(), out).out;
+            }
+
+            write_units(
+                [&out]<typename SizeRep, typename SizePeriod>( //
+                    const ::stdsharp::filesystem::space_size<SizeRep, SizePeriod> size
+                )
+                {
+                    // same notation as a stream with the classic locale
+                    if constexpr(::std::floating_point<SizeRep>)
+                        out = write_chars(out, size.size(), ::std::chars_format::general, 6);
+                    else
+                        out = write_chars(out, size.size());
+
+                    out = ::std::ranges::copy(
+                              ::stdsharp::filesystem::details::space_size_unit<SizePeriod>(),
+                              out
+                    )
+                              .out;
+                },
+                s,
+                fc
+            );
+
+            return out;
+        }
+
     public:
         constexpr auto parse(basic_format_parse_context<CharT>& ctx)
         {
@@ -501,19 +843,14 @@ namespace fmt
                 {
                     const auto align = fmtsharp::parse_align_spec(copied_ctx);
 
+                    // the width is parsed by the real context, which owns the argument ids
                     if(align != fmtsharp::align_t::none)
                     {
-                        const auto width =
-                            fmtsharp::parse_nested_integer_spec<::std::size_t>(copied_ctx);
-
-                        if(!width.valueless_by_exception())
-                        {
-                            fill_ = fill;
-                            align_ = align;
-                            width_ = width;
+                        fill_ = fill;
+                        align_ = align;
 
-                            ctx.advance_to(ctx.begin() + (size - ::std::ranges::size(copied_ctx)));
-                        }
+                        ctx.advance_to(ctx.begin() + (size - ::std::ranges::size(copied_ctx)));
+                        width_ = fmtsharp::parse_nested_integer_spec<::std::size_t>(ctx);
                     }
                 }
             }
@@ -521,6 +858,14 @@ namespace fmt
             precision_ = fmtsharp::parse_precision_spec(ctx);
             locale_ = fmtsharp::parse_locale_spec(ctx);
 
+            if(const auto it = ctx.begin();
+               it != ctx.end() && (*it == CharT{'h'} || *it == CharT{'H'}))
+            {
+                human_readable_ =
+                    *it == CharT{'h'} ? human_readable::binary : human_readable::decimal;
+                ctx.advance_to(it + 1);
+            }
+            else
             {
                 const auto [from_unit] = ::ctre::starts_with<R"((?:[KMGTPE]i?)?B|b)">(ctx);
 
@@ -543,179 +888,12 @@ namespace fmt
 
             const auto& fill = fill_.fill;
             const auto width = fmtsharp::get_arg(fc, width_);
-            const auto& formatted = [this, s = s, &fc]() mutable
-            {
-                const auto& precision = precision_.precision;
-                const auto from_unit = [from_unit_ = from_unit_]
-                {
-                    ::std::array<char, 4> from_unit{};
-
-                    ::std::ranges::transform(
-                        from_unit_,
-                        from_unit.begin(),
-                        [](const CharT c) { return static_cast<char>(c); } //
-                    );
-                    return from_unit;
-                }();
-
-                ::std::string_view current_unit{
-                    from_unit.begin(), //
-                    ::std::ranges::find(from_unit, char{}) //
-                };
-                ::std::basic_ostringstream<CharT> ss;
-
-                const auto do_format = [&current_unit, &ss, &s]
-                {
-                    const auto format_case =
-                        [&]<typename SpaceSize>( // clang-format off
-                        const identity<SpaceSize>,
-                        const ::std::string_view next_unit
-                    ) noexcept // clang-format on
-                    {
-                        return [&, next_unit](const ::std::string_view)
-                        {
-                            const SpaceSize cast_size = s;
-
-                            ss << cast_size;
-
-                            s -= space_size{cast_size};
-                            current_unit = next_unit;
-                        };
-                    };
 
-                    ::stdsharp::pattern_match(
-                        current_unit,
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit.empty(); },
-                            [](const ::std::string_view)
-                            { throw format_error{"Precision exceeded"}; } //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "b"; },
-                            format_case(identity<::stdsharp::filesystem::bits>{}, "")
-                            //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "B"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::bytes>{},
-                                "b") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "KiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::kibibytes>{},
-                                "B") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "KB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::kilobytes>{},
-                                "B") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "MiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::mebibytes>{},
-                                "KiB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "MB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::megabytes>{},
-                                "KB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "GiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::gibibytes>{},
-                                "MiB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "GB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::gigabytes>{},
-                                "MB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "TiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::tebibytes>{},
-                                "GiB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "TB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::terabytes>{},
-                                "GB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "PiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::pebibytes>{},
-                                "TiB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "PB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::petabytes>{},
-                                "TB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "EiB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::exbibytes>{},
-                                "PiB") //
-                        },
-                        ::std::pair{
-                            //
-                            [](const ::std::string_view unit) noexcept { return unit == "EB"; },
-                            format_case(
-                                identity<::stdsharp::filesystem::exabytes>{},
-                                "PB") //
-                        } //
-                    );
-                };
-
-                if(locale_.use_locale)
-#if __cpp_lib_format >= 201907L
-                    ss.imbue(fc.locale());
-#else
-                    ss.imbue(fc.locale().template get<::std::locale>());
-#endif
-                else
-                    ss.imbue(::std::locale::classic());
-
-                if(const auto precision_v = fmtsharp::get_arg(fc, precision); precision_v)
-                    for(auto i = *precision_v; i != 0; --i) do_format();
-                else
-                    while(s.size() > 0)
-                    {
-                        if(current_unit.empty())
-                        {
-                            ss << s;
-                            break;
-                        }
+            if(!fill || !width || align_ == fmtsharp::align_t::none) return write(fc.out(), s, fc);
 
-                        do_format();
-                    }
+            ::std::basic_string<CharT> formatted;
 
-                return ::std::move(ss).str();
-            }();
+            write(::std::back_inserter(formatted), s, fc);
 
             if(
                 [=, &formatted, &fc, align = align_]
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <sstream>
 #include <variant>
 #include <optional>
@@ -73,7 +74,10 @@ namespace stdsharp::fmt
                 fc,
                 []<typename U>(U&& u) noexcept -> ::std::optional<T>
                 {
-                    if constexpr(::std::convertible_to<U, T>)
+                    // negative widths and precisions aren't wrapped around
+                    if constexpr(::std::unsigned_integral<T> && ::std::signed_integral<U>)
+                        return u < 0 ? ::std::nullopt : ::std::optional<T>{static_cast<T>(u)};
+                    else if constexpr(::std::convertible_to<U, T>)
                         return static_cast<T>(::std::forward<U>(u));
                     else
                         return ::std::nullopt;
@@ -101,20 +105,15 @@ namespace stdsharp::fmt
             ResultT // clang-format off
         >; // clang-format on
 
-        if(spec.valueless_by_exception() || ::std::holds_alternative<::std::monostate>(spec))
-            return ::std::optional<result_t>{::std::nullopt};
-        return ::std::visit(
-            [&fc]<typename U>(U&& u) -> ::std::optional<result_t>
-            {
-                if constexpr(::std::same_as<::std::remove_cvref_t<U>, result_t>)
-                    return ::std::optional<result_t>{::std::forward<U>(u)};
-                else if constexpr(::std::same_as<::std::remove_cvref_t<U>, nested_arg_index>)
-                    return ::std::forward<U>(u).template get_from_context<result_t>(fc);
-                else
-                    return ::std::nullopt;
-            },
-            spec //
-        );
+        // the alternatives are checked directly, visiting the spec costs more than the lookup
+        if constexpr(::std::same_as<decltype(details::nested_spec_like(spec)), result_t>)
+            if(const auto value = ::std::get_if<result_t>(&spec); value != nullptr)
+                return ::std::optional<result_t>{*value};
+
+        if(const auto index = ::std::get_if<nested_arg_index>(&spec); index != nullptr)
+            return index->template get_from_context<result_t>(fc);
+
+        return ::std::optional<result_t>{::std::nullopt};
     }
 
     template<typename CharT>
@@ -273,6 +272,94 @@ namespace stdsharp::fmt
 
         return {};
     }
+
+    // format spec usable as a template argument
+    template<typename CharT, ::std::size_t N>
+    struct spec_string
+    {
+        using char_type = CharT;
+
+        ::std::array<CharT, N> str{};
+
+        constexpr spec_string(const CharT (&s)[N]) noexcept // NOLINT(*-explicit-*)
+        {
+            ::std::ranges::copy(s, str.begin());
+        }
+
+        [[nodiscard]] constexpr ::std::basic_string_view<CharT> view() const noexcept
+        {
+            return {str.data(), N - 1};
+        }
+    };
+
+    // Formatter of T with the spec parsed at compile time, formatting with it doesn't parse
+    // anything. Nested arguments in the spec don't compile since there is no argument to
+    // check them against.
+    template<typename T, spec_string Spec>
+    inline constexpr auto parsed_formatter = []
+    {
+        using char_type = typename decltype(Spec)::char_type;
+
+        FORMAT_NS::formatter<T, char_type> formatter{};
+        details::parse_context<char_type> ctx{Spec.view()};
+
+        ctx.advance_to(formatter.parse(ctx));
+        parse_end_assert(ctx);
+
+        return formatter;
+    }();
+
+    template<spec_string Spec, typename T>
+    struct spec_formatted
+    {
+        const T& value;
+    };
+
+    namespace details
+    {
+        template<spec_string Spec>
+        struct with_spec_fn
+        {
+            template<typename T>
+            [[nodiscard]] constexpr spec_formatted<Spec, T> operator()(const T& value
+            ) const noexcept
+            {
+                return {value};
+            }
+        };
+    }
+
+    // formats the value with the parsed_formatter of the spec, like "{}" with with_spec<"*>8">(v)
+    template<spec_string Spec>
+    inline constexpr details::with_spec_fn<Spec> with_spec{};
+}
+
+#if __cpp_lib_format >= 201907L
+namespace std
+#else
+namespace fmt
+#endif
+{
+    template<::stdsharp::fmt::spec_string Spec, typename T, typename CharT>
+        requires ::std::same_as<typename decltype(Spec)::char_type, CharT>
+    struct formatter<::stdsharp::fmt::spec_formatted<Spec, T>, CharT>
+    {
+        constexpr auto parse(basic_format_parse_context<CharT>& ctx)
+        {
+            ::stdsharp::fmt::parse_end_assert(ctx);
+            return ctx.begin();
+        }
+
+        template<typename OutputIt>
+        auto format(
+            const ::stdsharp::fmt::spec_formatted<Spec, T> formatted,
+            basic_format_context<OutputIt, CharT>& fc
+        ) const
+        {
+            auto formatter = ::stdsharp::fmt::parsed_formatter<T, Spec>;
+            return formatter.format(formatted.value, fc);
+        }
+    };
 }
 
 #undef FORMAT_NS
\ No newline at end of file
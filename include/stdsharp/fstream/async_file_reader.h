@@ -0,0 +1,808 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <future>
+#include <span>
+#include <thread>
+
+#include "../mutex/async_shared_mutex.h"
+#include "fstream.h"
+
+#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+    #include <fcntl.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define STDSHARP_HAS_PREAD true
+#else
+    #define STDSHARP_HAS_PREAD false
+#endif
+
+#if STDSHARP_HAS_PREAD && __has_include(<linux/io_uring.h>)
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+
+    #define STDSHARP_HAS_IO_URING true
+#else
+    #define STDSHARP_HAS_IO_URING false
+#endif
+
+namespace stdsharp
+{
+    // Reads whole files asynchronously. Open, stat, read and close are submitted to an io_uring
+    // where the kernel supports it, so a batch of files costs a few syscalls in total and the
+    // completions are driven by one thread. Otherwise every file is read on a pool of threads
+    // with pread. The reader must outlive its pending reads, destruction waits for them.
+    class async_file_reader
+    {
+        class request
+        {
+            friend class async_file_reader;
+
+            enum class stage
+            {
+                open,
+                stat,
+                read
+            };
+
+            ::std::filesystem::path path_;
+            ::std::string content_;
+            ::std::size_t offset_ = 0;
+            int fd_ = -1;
+            stage stage_ = stage::open;
+
+            // the file reports no size, like /proc entries and pipes, it is read in growing
+            // chunks from its current position until a read returns 0
+            bool streamed_ = false;
+            ::std::exception_ptr error_;
+            void (*complete_)(request&) noexcept;
+
+#if STDSHARP_HAS_IO_URING
+            struct ::statx statx_
+            {
+            };
+#endif
+
+            void fail(const char* const what, const int error)
+            {
+                error_ = ::std::make_exception_ptr(
+                    ::std::filesystem::filesystem_error{
+                        what,
+                        path_,
+                        ::std::error_code{error, ::std::system_category()} //
+                    }
+                );
+            }
+
+            // the content is overwritten by the reads, a short read shrinks it
+            void resize_for_read(const ::std::size_t size)
+            {
+                content_.resize_and_overwrite(
+                    size,
+                    [](const char* /*unused*/, const ::std::size_t n) noexcept { return n; }
+                );
+            }
+
+            void start_read(const ::std::size_t size)
+            {
+                streamed_ = size == 0;
+                resize_for_read(streamed_ ? 4096 : size);
+            }
+
+            // whether another read is needed after the buffer is filled up to the offset
+            [[nodiscard]] bool next_chunk()
+            {
+                if(offset_ != content_.size()) return true;
+                if(!streamed_) return false;
+
+                resize_for_read(content_.size() * 2);
+                return true;
+            }
+
+            void read_blocking()
+            {
+#if STDSHARP_HAS_PREAD
+                fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(*-vararg)
+                if(fd_ == -1)
+                {
+                    fail("async_file_reader open failed", errno);
+                    return;
+                }
+
+                struct ::stat stat_buf
+                {
+                };
+
+                if(::fstat(fd_, &stat_buf) == -1) fail("async_file_reader stat failed", errno);
+                else
+                {
+                    start_read(static_cast<::std::size_t>(stat_buf.st_size));
+
+                    while(next_chunk())
+                    {
+                        const auto data = content_.data() + offset_;
+                        const auto size = content_.size() - offset_;
+                        const auto read = streamed_ ?
+                            ::read(fd_, data, size) :
+                            ::pread(fd_, data, size, static_cast<::off_t>(offset_));
+
+                        if(read > 0) offset_ += static_cast<::std::size_t>(read);
+                        else if(read == 0)
+                        {
+                            content_.resize(offset_);
+                            break;
+                        }
+                        else if(errno != EINTR)
+                        {
+                            fail("async_file_reader read failed", errno);
+                            break;
+                        }
+                    }
+                }
+
+                ::close(fd_);
+#else
+                try
+                {
+                    content_ = read_all_text(path_);
+                }
+                catch(...)
+                {
+                    error_ = ::std::current_exception();
+                }
+#endif
+            }
+
+        protected:
+            request(::std::filesystem::path path, void (*complete)(request&) noexcept):
+                path_(::std::move(path)), complete_(complete)
+            {
+            }
+
+            [[nodiscard]] ::std::string take()
+            {
+                if(error_) ::std::rethrow_exception(error_);
+                return ::std::move(content_);
+            }
+        };
+
+        class future_request : request
+        {
+            friend class async_file_reader;
+
+            ::std::promise<::std::string> promise_;
+
+            static void complete(request& r) noexcept
+            {
+                auto& self = static_cast<future_request&>(r);
+
+                try
+                {
+                    self.promise_.set_value(self.take());
+                }
+                catch(...)
+                {
+                    self.promise_.set_exception(::std::current_exception());
+                }
+
+                delete &self; // NOLINT(*-owning-memory)
+            }
+
+            explicit future_request(::std::filesystem::path path):
+                request(::std::move(path), complete)
+            {
+            }
+        };
+
+#if STDSHARP_HAS_IO_URING
+        class ring
+        {
+            static constexpr ::std::uint64_t ignored_tag = 0;
+            static constexpr ::std::uint64_t stop_tag = 1;
+
+            int fd_ = -1;
+            unsigned entries_ = 0;
+
+            void* mapping_ = nullptr;
+            ::std::size_t mapping_size_ = 0;
+            ::io_uring_sqe* sqes_ = nullptr;
+
+            unsigned* sq_head_ = nullptr;
+            unsigned* sq_tail_ = nullptr;
+            unsigned sq_mask_ = 0;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned cq_mask_ = 0;
+            ::io_uring_cqe* cqes_ = nullptr;
+
+            ::std::mutex submit_mutex_;
+
+            // requests beyond the queue depth wait here until a finishing request hands its
+            // slot over, so submitting never blocks the completer on its own completions
+            ::std::deque<request*> waiting_;
+            unsigned free_slots_ = 0;
+
+            ::std::atomic_size_t in_flight_{0};
+            bool stopping_ = false;
+            ::std::jthread completer_;
+
+            template<typename T>
+            [[nodiscard]] T* at_offset(const unsigned offset) const noexcept
+            {
+                return reinterpret_cast<T*>(static_cast<char*>(mapping_) + offset); // NOLINT
+            }
+
+            static ::std::atomic_ref<unsigned> atomic(unsigned* const value) noexcept
+            {
+                return ::std::atomic_ref{*value};
+            }
+
+            int enter(const unsigned to_submit, const unsigned min_complete, const unsigned flags)
+                const noexcept
+            {
+                return static_cast<int>(::syscall(
+                    __NR_io_uring_enter,
+                    fd_,
+                    to_submit,
+                    min_complete,
+                    flags,
+                    nullptr,
+                    0
+                ));
+            }
+
+            // entries written to the submission queue that the kernel hasn't consumed yet
+            [[nodiscard]] unsigned pending() const noexcept
+            {
+                return *sq_tail_ - atomic(sq_head_).load(::std::memory_order_acquire);
+            }
+
+            void flush() const noexcept
+            {
+                for(auto to_submit = pending(); to_submit != 0; to_submit = pending())
+                    if(enter(to_submit, 0, 0) < 0 && errno != EINTR && errno != EAGAIN &&
+                       errno != EBUSY)
+                        break;
+            }
+
+            // the submit mutex must be held, returns the error of the kernel if the queue is
+            // full and the kernel doesn't take entries to make room
+            [[nodiscard]] int push(const ::io_uring_sqe& sqe)
+            {
+                if(pending() == entries_)
+                {
+                    flush();
+                    if(pending() == entries_) return errno;
+                }
+
+                const auto tail = *sq_tail_;
+                sqes_[tail & sq_mask_] = sqe;
+                atomic(sq_tail_).store(tail + 1, ::std::memory_order_release);
+                return 0;
+            }
+
+            [[nodiscard]] static ::io_uring_sqe next_sqe(request& r) noexcept
+            {
+                ::io_uring_sqe sqe{};
+                sqe.fd = r.fd_;
+                sqe.user_data = reinterpret_cast<::std::uint64_t>(&r); // NOLINT
+
+                switch(r.stage_)
+                {
+                case request::stage::open:
+                    sqe.opcode = IORING_OP_OPENAT;
+                    sqe.fd = AT_FDCWD;
+                    sqe.addr = reinterpret_cast<::std::uint64_t>(r.path_.c_str()); // NOLINT
+                    sqe.open_flags = O_RDONLY | O_CLOEXEC;
+                    break;
+
+                case request::stage::stat:
+                    sqe.opcode = IORING_OP_STATX;
+                    sqe.addr = reinterpret_cast<::std::uint64_t>(""); // NOLINT
+                    sqe.len = STATX_SIZE;
+                    sqe.statx_flags = AT_EMPTY_PATH;
+                    sqe.off = reinterpret_cast<::std::uint64_t>(&r.statx_); // NOLINT
+                    break;
+
+                case request::stage::read:
+                    sqe.opcode = IORING_OP_READ;
+                    sqe.addr = reinterpret_cast<::std::uint64_t>(r.content_.data() + r.offset_);
+                    sqe.len = static_cast<unsigned>(
+                        ::std::min<::std::size_t>(r.content_.size() - r.offset_, 1U << 30U)
+                    );
+                    // -1 reads from the current position, which pipes require
+                    sqe.off = r.streamed_ ? ~::std::uint64_t{0} : r.offset_;
+                    break;
+                }
+
+                return sqe;
+            }
+
+            void complete(request& r)
+            {
+                in_flight_.fetch_sub(1, ::std::memory_order_relaxed);
+                r.complete_(r);
+            }
+
+            // a request the queue doesn't take fails, it is completed once the lock is released
+            static void reject(request& r, const int error, ::std::vector<request*>& rejected)
+            {
+                r.fail("async_file_reader submit failed", error);
+                rejected.push_back(&r);
+            }
+
+            // hands the slot of a finished request over to the oldest waiting one, the submit
+            // mutex must be held
+            void release_slot(::std::vector<request*>& rejected)
+            {
+                while(!waiting_.empty())
+                {
+                    auto& next = *waiting_.front();
+                    waiting_.pop_front();
+
+                    const auto error = push(next_sqe(next));
+                    if(error == 0) return;
+
+                    reject(next, error, rejected);
+                }
+
+                ++free_slots_;
+            }
+
+            void push_next(request& r)
+            {
+                int error = 0;
+                {
+                    const ::std::scoped_lock lock{submit_mutex_};
+                    error = push(next_sqe(r));
+                }
+
+                if(error == 0) return;
+
+                r.fail("async_file_reader submit failed", error);
+                finish(r);
+            }
+
+            void finish(request& r)
+            {
+                ::std::vector<request*> rejected;
+
+                {
+                    const ::std::scoped_lock lock{submit_mutex_};
+
+                    if(r.fd_ != -1)
+                    {
+                        ::io_uring_sqe sqe{};
+                        sqe.opcode = IORING_OP_CLOSE;
+                        sqe.fd = r.fd_;
+                        sqe.user_data = ignored_tag;
+                        if(push(sqe) != 0) ::close(r.fd_);
+                    }
+
+                    release_slot(rejected);
+                }
+
+                complete(r);
+                for(auto* const rejected_request : rejected) complete(*rejected_request);
+            }
+
+            void on_complete(request& r, const int result)
+            {
+                if(result == -EINTR || result == -EAGAIN)
+                {
+                    push_next(r);
+                    return;
+                }
+
+                switch(r.stage_)
+                {
+                case request::stage::open:
+                    if(result < 0)
+                    {
+                        r.fail("async_file_reader open failed", -result);
+                        break;
+                    }
+
+                    r.fd_ = result;
+                    r.stage_ = request::stage::stat;
+                    push_next(r);
+                    return;
+
+                case request::stage::stat:
+                    if(result < 0)
+                    {
+                        r.fail("async_file_reader stat failed", -result);
+                        break;
+                    }
+
+                    r.start_read(r.statx_.stx_size);
+                    r.stage_ = request::stage::read;
+                    push_next(r);
+                    return;
+
+                case request::stage::read:
+                    if(result < 0)
+                    {
+                        r.fail("async_file_reader read failed", -result);
+                        break;
+                    }
+
+                    if(result == 0)
+                    {
+                        r.content_.resize(r.offset_);
+                        break;
+                    }
+
+                    r.offset_ += static_cast<::std::size_t>(result);
+                    if(!r.next_chunk()) break;
+
+                    push_next(r);
+                    return;
+                }
+
+                finish(r);
+            }
+
+            // submits what the completions pushed and waits for the next completions
+            void complete_all()
+            {
+                while(!stopping_ || in_flight_.load(::std::memory_order_relaxed) != 0)
+                {
+                    unsigned to_submit = 0;
+                    {
+                        const ::std::scoped_lock lock{submit_mutex_};
+                        to_submit = pending();
+                    }
+
+                    enter(to_submit, 1, IORING_ENTER_GETEVENTS);
+
+                    auto head = *cq_head_;
+                    const auto tail = atomic(cq_tail_).load(::std::memory_order_acquire);
+
+                    // the requests were published by the release of the submission tail, the
+                    // kernel orders them before their completions
+                    (void)atomic(sq_tail_).load(::std::memory_order_acquire);
+
+                    for(; head != tail; ++head)
+                    {
+                        const auto& cqe = cqes_[head & cq_mask_];
+                        const auto user_data = cqe.user_data;
+                        const auto result = cqe.res;
+
+                        atomic(cq_head_).store(head + 1, ::std::memory_order_release);
+
+                        if(user_data == stop_tag) stopping_ = true;
+                        else if(user_data != ignored_tag)
+                            on_complete(*reinterpret_cast<request*>(user_data), result); // NOLINT
+                    }
+                }
+            }
+
+        public:
+            // leaves the ring invalid when the kernel lacks io_uring or its file operations
+            explicit ring(const unsigned entries)
+            {
+                ::io_uring_params params{};
+
+                fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+                if(fd_ < 0) return;
+
+                // openat, statx and close operations came with the same kernel as fast poll
+                if((params.features & IORING_FEAT_SINGLE_MMAP) == 0 ||
+                   (params.features & IORING_FEAT_FAST_POLL) == 0)
+                {
+                    ::close(fd_);
+                    fd_ = -1;
+                    return;
+                }
+
+                entries_ = params.sq_entries;
+                mapping_size_ = ::std::max(
+                    params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                    params.cq_off.cqes + params.cq_entries * sizeof(::io_uring_cqe)
+                );
+
+                mapping_ = ::mmap(
+                    nullptr,
+                    mapping_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd_,
+                    IORING_OFF_SQ_RING
+                );
+
+                void* const sqes = ::mmap(
+                    nullptr,
+                    entries_ * sizeof(::io_uring_sqe),
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd_,
+                    IORING_OFF_SQES
+                );
+
+                // NOLINTNEXTLINE(*-cstyle-cast, *-int-to-ptr)
+                if(mapping_ == MAP_FAILED || sqes == MAP_FAILED)
+                {
+                    if(mapping_ != MAP_FAILED) // NOLINT(*-cstyle-cast, *-int-to-ptr)
+                        ::munmap(mapping_, mapping_size_);
+                    if(sqes != MAP_FAILED) // NOLINT(*-cstyle-cast, *-int-to-ptr)
+                        ::munmap(sqes, entries_ * sizeof(::io_uring_sqe));
+
+                    mapping_ = nullptr;
+                    ::close(fd_);
+                    fd_ = -1;
+                    return;
+                }
+
+                sqes_ = static_cast<::io_uring_sqe*>(sqes);
+                sq_head_ = at_offset<unsigned>(params.sq_off.head);
+                sq_tail_ = at_offset<unsigned>(params.sq_off.tail);
+                sq_mask_ = *at_offset<unsigned>(params.sq_off.ring_mask);
+                cq_head_ = at_offset<unsigned>(params.cq_off.head);
+                cq_tail_ = at_offset<unsigned>(params.cq_off.tail);
+                cq_mask_ = *at_offset<unsigned>(params.cq_off.ring_mask);
+                cqes_ = at_offset<::io_uring_cqe>(params.cq_off.cqes);
+
+                // submission entries are always written at the index of the tail
+                const auto array = at_offset<unsigned>(params.sq_off.array);
+                for(unsigned i = 0; i < entries_; ++i) array[i] = i;
+
+                free_slots_ = entries_;
+                completer_ = ::std::jthread{[this] { complete_all(); }};
+            }
+
+            ring(const ring&) = delete;
+            ring(ring&&) = delete;
+            ring& operator=(const ring&) = delete;
+            ring& operator=(ring&&) = delete;
+
+            ~ring()
+            {
+                if(!valid()) return;
+
+                ::io_uring_sqe sqe{};
+                sqe.opcode = IORING_OP_NOP;
+                sqe.user_data = stop_tag;
+
+                // the completer keeps taking completions, so the queue makes room eventually
+                for(auto pushed = false; !pushed; ::std::this_thread::yield())
+                {
+                    const ::std::scoped_lock lock{submit_mutex_};
+                    pushed = push(sqe) == 0;
+                    flush();
+                }
+
+                completer_.join();
+
+                ::munmap(sqes_, entries_ * sizeof(::io_uring_sqe));
+                ::munmap(mapping_, mapping_size_);
+                ::close(fd_);
+            }
+
+            [[nodiscard]] bool valid() const noexcept { return fd_ != -1; }
+
+            void submit(const ::std::span<request* const> requests)
+            {
+                ::std::vector<request*> rejected;
+
+                {
+                    const ::std::scoped_lock lock{submit_mutex_};
+
+                    in_flight_.fetch_add(requests.size(), ::std::memory_order_relaxed);
+
+                    for(auto* const r : requests)
+                        if(free_slots_ == 0) waiting_.push_back(r);
+                        else if(const auto error = push(next_sqe(*r)); error != 0)
+                            reject(*r, error, rejected);
+                        else --free_slots_;
+
+                    flush();
+                }
+
+                for(auto* const r : rejected) complete(*r);
+            }
+        };
+
+        ::std::unique_ptr<ring> ring_;
+#endif
+
+        class thread_pool
+        {
+            ::std::mutex mutex_;
+            ::std::condition_variable_any not_empty_;
+            ::std::deque<request*> queue_;
+            ::std::vector<::std::jthread> workers_;
+
+            // pending requests are still read after a stop request
+            void work(const ::std::stop_token& token)
+            {
+                while(true)
+                {
+                    request* r = nullptr;
+
+                    {
+                        ::std::unique_lock lock{mutex_};
+
+                        if(!not_empty_.wait(lock, token, [this] { return !queue_.empty(); }))
+                            return;
+
+                        r = queue_.front();
+                        queue_.pop_front();
+                    }
+
+                    r->read_blocking();
+                    r->complete_(*r);
+                }
+            }
+
+        public:
+            explicit thread_pool(const ::std::size_t thread_count)
+            {
+                workers_.reserve(thread_count);
+
+                for(::std::size_t i = 0; i < thread_count; ++i)
+                    workers_.emplace_back([this](const ::std::stop_token& token) { work(token); });
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool(thread_pool&&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+            thread_pool& operator=(thread_pool&&) = delete;
+
+            ~thread_pool() = default;
+
+            void submit(const ::std::span<request* const> requests)
+            {
+                {
+                    const ::std::scoped_lock lock{mutex_};
+                    queue_.insert(queue_.end(), requests.begin(), requests.end());
+                }
+
+                if(requests.size() == 1) not_empty_.notify_one();
+                else not_empty_.notify_all();
+            }
+        };
+
+        ::std::unique_ptr<thread_pool> pool_;
+
+        void submit(const ::std::span<request* const> requests)
+        {
+#if STDSHARP_HAS_IO_URING
+            if(ring_)
+            {
+                ring_->submit(requests);
+                return;
+            }
+#endif
+            pool_->submit(requests);
+        }
+
+    public:
+        static constexpr unsigned default_queue_depth = 256;
+
+        template<::std::invocable<::std::coroutine_handle<>> Executor>
+        class read_awaitable : request
+        {
+            friend class async_file_reader;
+
+            async_file_reader* reader_;
+            [[no_unique_address]] Executor executor_;
+            ::std::coroutine_handle<> handle_{};
+
+            static void resume_handle(request& r) noexcept
+            {
+                auto& self = static_cast<read_awaitable&>(r);
+
+                // the awaitable lives in the frame the executor resumes
+                auto executor = ::std::move(self.executor_);
+                const auto handle = self.handle_;
+
+                ::std::invoke(executor, handle);
+            }
+
+            read_awaitable(
+                async_file_reader& reader,
+                ::std::filesystem::path path,
+                Executor executor //
+            ):
+                request(::std::move(path), resume_handle),
+                reader_(&reader),
+                executor_(::std::move(executor))
+            {
+            }
+
+        public:
+            read_awaitable(const read_awaitable&) = delete;
+            read_awaitable(read_awaitable&&) = delete;
+            read_awaitable& operator=(const read_awaitable&) = delete;
+            read_awaitable& operator=(read_awaitable&&) = delete;
+
+            ~read_awaitable() = default;
+
+            [[nodiscard]] static constexpr bool await_ready() noexcept { return false; }
+
+            void await_suspend(const ::std::coroutine_handle<> handle)
+            {
+                handle_ = handle;
+
+                request* const r = this;
+                reader_->submit({&r, 1});
+            }
+
+            // throws filesystem_error if the file can't be read
+            [[nodiscard]] ::std::string await_resume() { return take(); }
+        };
+
+        // a queue depth of 0 always uses the thread pool
+        explicit async_file_reader(
+            const unsigned queue_depth = default_queue_depth,
+            const ::std::size_t thread_count =
+                ::std::max(::std::thread::hardware_concurrency(), 1U) //
+        )
+        {
+#if STDSHARP_HAS_IO_URING
+            if(queue_depth != 0)
+            {
+                ring_ = ::std::make_unique<ring>(queue_depth);
+                if(ring_->valid()) return;
+                ring_.reset();
+            }
+#else
+            (void)queue_depth;
+#endif
+            pool_ = ::std::make_unique<thread_pool>(::std::max(thread_count, ::std::size_t{1}));
+        }
+
+        [[nodiscard]] bool uses_io_uring() const noexcept { return pool_ == nullptr; }
+
+        // the future throws filesystem_error if the file can't be read
+        [[nodiscard]] ::std::future<::std::string> read_text(::std::filesystem::path path)
+        {
+            auto r = ::std::unique_ptr<future_request>{new future_request{::std::move(path)}};
+            auto future = r->promise_.get_future();
+            request* const ptr = r.release();
+
+            submit({&ptr, 1});
+            return future;
+        }
+
+        // submits all the reads at once
+        template<::std::ranges::input_range Paths>
+            requires ::std::constructible_from<
+                ::std::filesystem::path,
+                ::std::ranges::range_reference_t<Paths> // clang-format off
+            > // clang-format on
+        [[nodiscard]] auto read_texts(Paths&& paths)
+        {
+            ::std::vector<::std::unique_ptr<future_request>> owned;
+            ::std::vector<::std::future<::std::string>> futures;
+
+            for(auto&& path : paths)
+            {
+                owned.emplace_back(new future_request{::std::filesystem::path{path}});
+                futures.emplace_back(owned.back()->promise_.get_future());
+            }
+
+            ::std::vector<request*> requests(owned.size());
+            for(::std::size_t i = 0; i < owned.size(); ++i) requests[i] = owned[i].release();
+
+            submit(requests);
+            return futures;
+        }
+
+        // the coroutine is resumed through the executor on the thread completing the read
+        template<::std::invocable<::std::coroutine_handle<>> Executor = inline_executor_fn>
+        [[nodiscard]] read_awaitable<Executor>
+            async_read_text(::std::filesystem::path path, Executor executor = {})
+        {
+            return {*this, ::std::move(path), ::std::move(executor)};
+        }
+    };
+}
+
+#undef STDSHARP_HAS_IO_URING
+#undef STDSHARP_HAS_PREAD
\ No newline at end of file
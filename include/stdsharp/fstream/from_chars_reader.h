@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <istream>
+#include <vector>
+#include <ranges>
+
+#include "../concepts/concepts.h"
+
+namespace stdsharp
+{
+    // numbers that operator>> extracts as numbers, character types are read as characters
+    template<typename T>
+    concept from_chars_parsable = concepts::arithmetic<T> && !concepts::character<T> &&
+        !concepts::same_as_any<T, bool, signed char, unsigned char> &&
+        requires(const char* ptr, T& value) { ::std::from_chars(ptr, ptr, value); };
+
+    // Input view of the whitespace separated numbers of a stream. The stream buffer is read in
+    // large chunks and parsed with from_chars, so no locale or sentry is involved per element.
+    // A token that fails to parse stops the view and sets failbit on the stream.
+    template<from_chars_parsable T>
+    class from_chars_reader : public ::std::ranges::view_interface<from_chars_reader<T>>
+    {
+        ::std::istream* is_;
+        ::std::vector<char> buffer_;
+        ::std::size_t begin_ = 0;
+        ::std::size_t end_ = 0;
+        bool eof_ = false;
+        bool done_ = false;
+        T current_{};
+
+        [[nodiscard]] static constexpr bool is_space(const char c) noexcept
+        {
+            return c == ' ' || (c >= '\t' && c <= '\r');
+        }
+
+        // keeps the unparsed bytes and reads the next chunk after them, a token longer than
+        // the whole buffer doubles it
+        void fill()
+        {
+            if(begin_ == 0 && end_ == buffer_.size()) buffer_.resize(buffer_.size() * 2);
+            else if(begin_ != 0)
+            {
+                ::std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+                end_ -= begin_;
+                begin_ = 0;
+            }
+
+            const auto read = is_->rdbuf()->sgetn(
+                buffer_.data() + end_,
+                static_cast<::std::streamsize>(buffer_.size() - end_)
+            );
+
+            if(read <= 0)
+            {
+                eof_ = true;
+                is_->setstate(::std::ios::eofbit);
+            }
+            else end_ += static_cast<::std::size_t>(read);
+        }
+
+        void next()
+        {
+            while(true)
+            {
+                const auto data = buffer_.data();
+
+                while(begin_ != end_ && is_space(data[begin_])) ++begin_;
+
+                if(begin_ == end_)
+                {
+                    if(eof_)
+                    {
+                        done_ = true;
+                        return;
+                    }
+
+                    fill();
+                    continue;
+                }
+
+                const auto last = data + end_;
+                auto first = data + begin_;
+
+                // operator>> accepts a plus sign, from_chars doesn't
+                if(*first == '+' && first + 1 != last && first[1] != '-') ++first;
+
+                const auto [ptr, ec] = ::std::from_chars(first, last, current_);
+
+                const auto parsed = ec == ::std::errc{} && (ptr == last || is_space(*ptr));
+
+                // the token may continue in the next chunk
+                if((!parsed || ptr == last) && !eof_ &&
+                   ::std::find_if(data + begin_, last, is_space) == last)
+                {
+                    fill();
+                    continue;
+                }
+
+                if(!parsed)
+                {
+                    is_->setstate(::std::ios::failbit);
+                    done_ = true;
+                    return;
+                }
+
+                begin_ = static_cast<::std::size_t>(ptr - data);
+                return;
+            }
+        }
+
+    public:
+        static constexpr ::std::size_t default_chunk_size = 1 << 16;
+
+        class iterator
+        {
+            from_chars_reader* reader_ = nullptr;
+
+        public:
+            using value_type = T;
+            using difference_type = ::std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(from_chars_reader& reader) noexcept: reader_(&reader) {}
+
+            [[nodiscard]] const T& operator*() const noexcept { return reader_->current_; }
+
+            iterator& operator++()
+            {
+                reader_->next();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            [[nodiscard]] bool operator==(const ::std::default_sentinel_t /*unused*/) const noexcept
+            {
+                return reader_->done_;
+            }
+        };
+
+        explicit from_chars_reader(
+            ::std::istream& is,
+            const ::std::size_t chunk_size = default_chunk_size //
+        ):
+            is_(&is), buffer_(::std::max(chunk_size, ::std::size_t{1}))
+        {
+        }
+
+        // parses the first element, the view can be iterated only once
+        [[nodiscard]] iterator begin()
+        {
+            next();
+            return iterator{*this};
+        }
+
+        [[nodiscard]] static constexpr ::std::default_sentinel_t end() noexcept { return {}; }
+    };
+}
\ No newline at end of file
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <exception>
 #include <fstream>
 #include <filesystem>
+#include <mutex>
+#include <spanstream>
+#include <thread>
 
 #include "../containers/actions.h"
+#include "from_chars_reader.h"
+#include "mapped_file.h"
 
 namespace stdsharp
 {
@@ -31,12 +37,16 @@ namespace stdsharp
         template<typename T>
             requires ::std::invocable<
                 details::get_from_stream_fn<T>,
-                ::std::ifstream // clang-format off
+                ::std::istream& // clang-format off
             > // clang-format on
         struct read_all_to_container_fn
         {
             template<typename Container = ::std::vector<T>>
-                requires ::std::invocable<read_all_to_container_fn, Container&>
+                requires ::std::invocable<
+                    decltype(actions::emplace_back),
+                    Container&,
+                    T // clang-format off
+                > // clang-format on
             [[nodiscard]] auto& operator()(
                 Container& container,
                 const ::std::filesystem::path& path //
@@ -54,7 +64,12 @@ namespace stdsharp
                 > // clang-format on
             [[nodiscard]] constexpr auto& operator()(Container& container, ::std::istream& is) const
             {
-                while(is) actions::emplace_back(container, get_from_stream<T>(is));
+                if constexpr(from_chars_parsable<T>)
+                    for(const auto value : from_chars_reader<T>{is})
+                        actions::emplace_back(container, value);
+                else // a failed extraction ends the elements without appending
+                    for(auto value = get_from_stream<T>(is); is; value = get_from_stream<T>(is))
+                        actions::emplace_back(container, ::std::move(value));
 
                 return container;
             }
@@ -77,7 +92,8 @@ namespace stdsharp
             [[nodiscard]] constexpr auto operator()(::std::istream& is) const
             {
                 Container container{};
-                return read_all_to_container<T>(container, is);
+                (void)read_all_to_container<T>(container, is);
+                return container;
             }
 
             [[nodiscard]] auto operator()(const ::std::filesystem::path& path) const
@@ -99,16 +115,149 @@ namespace stdsharp
                 return str;
             }
 
+            // non-empty regular files are sized up front and copied once from the mapping, others
+            // such as /proc entries, pipes and devices report no size and are read as streams
             [[nodiscard]] auto operator()(const ::std::filesystem::path& path) const
             {
+                ::std::error_code ec;
+
+                if(::std::filesystem::is_regular_file(path, ec))
+                    if(const auto size = ::std::filesystem::file_size(path, ec); !ec && size > 0)
+                    {
+                        const mapped_file file{path};
+                        return ::std::string{file.text()};
+                    }
+
                 ::std::ifstream fs{path};
                 return (*this)(fs);
             }
         };
+
+        struct read_all_mapped_fn
+        {
+            [[nodiscard]] auto operator()(
+                const ::std::filesystem::path& path,
+                const mapped_file::access_advice advice = mapped_file::access_advice::sequential
+            ) const
+            {
+                return mapped_file{path, advice};
+            }
+        };
     }
 
     template<typename T, typename Container = ::std::vector<T>>
     inline constexpr details::read_all_fn<T, Container> read_all{};
 
+    struct parallel_read_options
+    {
+        ::std::size_t thread_count = ::std::max(::std::thread::hardware_concurrency(), 1U);
+
+        // merges the parts in file order, otherwise in the order the workers finish
+        bool ordered = true;
+    };
+
+    namespace details
+    {
+        template<typename T, typename Container>
+            requires ::std::invocable<read_all_fn<T, Container>, ::std::istream&>
+        struct read_all_parallel_fn
+        {
+        private:
+            // splits text into at most count parts ending right after a line break
+            [[nodiscard]] static auto split_lines(
+                const ::std::string_view text,
+                const ::std::size_t count //
+            )
+            {
+                ::std::vector<::std::string_view> parts;
+                const auto part_size = text.size() / count + 1;
+
+                for(::std::size_t begin = 0; begin < text.size();)
+                {
+                    auto end = text.find('\n', ::std::min(begin + part_size, text.size()) - 1);
+                    end = end == ::std::string_view::npos ? text.size() : end + 1;
+
+                    parts.push_back(text.substr(begin, end - begin));
+                    begin = end;
+                }
+
+                return parts;
+            }
+
+            static void append(Container& container, Container&& part)
+            {
+                for(auto& value : part) actions::emplace_back(container, ::std::move(value));
+            }
+
+        public:
+            // every part is parsed by read_all on its own thread, so elements must not span lines
+            [[nodiscard]] Container operator()(
+                const ::std::filesystem::path& path,
+                const parallel_read_options options = {} //
+            ) const
+            {
+                const mapped_file file{path};
+                const auto parts =
+                    split_lines(file.text(), ::std::max(options.thread_count, ::std::size_t{1}));
+                ::std::vector<Container> results(parts.size());
+                ::std::vector<::std::exception_ptr> exceptions(parts.size());
+                Container container{};
+                ::std::mutex container_mutex;
+
+                {
+                    ::std::vector<::std::jthread> workers;
+                    workers.reserve(parts.size());
+
+                    for(::std::size_t i = 0; i < parts.size(); ++i)
+                        workers.emplace_back(
+                            [&, i]
+                            {
+                                try
+                                {
+                                    ::std::ispanstream is{::std::span{parts[i]}};
+                                    auto result = read_all<T, Container>(is);
+
+                                    if(options.ordered) results[i] = ::std::move(result);
+                                    else
+                                    {
+                                        const ::std::scoped_lock lock{container_mutex};
+                                        append(container, ::std::move(result));
+                                    }
+                                }
+                                catch(...)
+                                {
+                                    exceptions[i] = ::std::current_exception();
+                                }
+                            }
+                        );
+                }
+
+                for(const auto& exception : exceptions)
+                    if(exception) ::std::rethrow_exception(exception);
+
+                if(options.ordered)
+                {
+                    if constexpr(requires(::std::size_t size) { container.reserve(size); })
+                    {
+                        ::std::size_t size = 0;
+                        for(const auto& result : results) size += ::std::ranges::size(result);
+                        container.reserve(size);
+                    }
+
+                    for(auto& result : results) append(container, ::std::move(result));
+                }
+
+                return container;
+            }
+        };
+    }
+
+    // reads a file of line separated elements with one worker per line aligned part
+    template<typename T, typename Container = ::std::vector<T>>
+    inline constexpr details::read_all_parallel_fn<T, Container> read_all_parallel{};
+
     inline constexpr details::read_all_text_fn read_all_text{};
+
+    // maps the file instead of copying it, the text stays valid while the result lives
+    inline constexpr details::read_all_mapped_fn read_all_mapped{};
 }
\ No newline at end of file
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#if __has_include(<sys/mman.h>)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+
+    #define STDSHARP_HAS_MMAP true
+#else
+    #define STDSHARP_HAS_MMAP false
+#endif
+
+namespace stdsharp
+{
+    // Read only view of a whole file. The file is memory mapped where mmap is available, so
+    // the content is paged in on access instead of copied, otherwise it is read into a buffer.
+    class mapped_file
+    {
+    public:
+        enum class access_advice
+        {
+            normal,
+            sequential,
+            random
+        };
+
+    private:
+        const char* data_ = nullptr;
+        ::std::size_t size_ = 0;
+
+#if STDSHARP_HAS_MMAP
+        [[noreturn]] static void throw_error(
+            const char* const what,
+            const ::std::filesystem::path& path,
+            const int error = errno //
+        )
+        {
+            throw ::std::filesystem::filesystem_error{
+                what,
+                path,
+                ::std::error_code{error, ::std::system_category()} //
+            };
+        }
+
+        [[nodiscard]] static int to_madvise(const access_advice advice) noexcept
+        {
+            switch(advice)
+            {
+            case access_advice::sequential: return MADV_SEQUENTIAL;
+            case access_advice::random: return MADV_RANDOM;
+            default: return MADV_NORMAL;
+            }
+        }
+
+        void map(const ::std::filesystem::path& path, const access_advice advice)
+        {
+            const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT(*-vararg)
+            if(fd == -1) throw_error("mapped_file open failed", path);
+
+            struct ::stat stat_buf
+            {
+            };
+
+            if(::fstat(fd, &stat_buf) == -1)
+            {
+                const auto error = errno;
+                ::close(fd);
+                throw_error("mapped_file stat failed", path, error);
+            }
+
+            size_ = static_cast<::std::size_t>(stat_buf.st_size);
+
+            // mmap rejects empty lengths, an empty file is an empty view
+            if(size_ != 0)
+            {
+                void* const ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if(ptr == MAP_FAILED) // NOLINT(*-cstyle-cast, *-int-to-ptr)
+                {
+                    const auto error = errno;
+                    ::close(fd);
+                    throw_error("mapped_file mmap failed", path, error);
+                }
+
+                data_ = static_cast<const char*>(ptr);
+                ::madvise(ptr, size_, to_madvise(advice));
+            }
+
+            ::close(fd);
+        }
+
+        void unmap() noexcept
+        {
+            if(data_ != nullptr) ::munmap(const_cast<char*>(data_), size_); // NOLINT
+        }
+#else
+        ::std::unique_ptr<char[]> buffer_; // NOLINT(*-avoid-c-arrays)
+
+        void map(const ::std::filesystem::path& path, const access_advice /*unused*/)
+        {
+            ::std::ifstream fs{path, ::std::ios::binary};
+
+            if(!fs)
+                throw ::std::filesystem::filesystem_error{
+                    "mapped_file open failed",
+                    path,
+                    ::std::make_error_code(::std::errc::no_such_file_or_directory) //
+                };
+
+            size_ = static_cast<::std::size_t>(::std::filesystem::file_size(path));
+            buffer_ = ::std::make_unique_for_overwrite<char[]>(size_); // NOLINT(*-c-arrays)
+            fs.read(buffer_.get(), static_cast<::std::streamsize>(size_));
+            size_ = static_cast<::std::size_t>(fs.gcount());
+            data_ = buffer_.get();
+        }
+
+        static constexpr void unmap() noexcept {}
+#endif
+
+    public:
+        mapped_file() = default;
+
+        explicit mapped_file(
+            const ::std::filesystem::path& path,
+            const access_advice advice = access_advice::sequential //
+        )
+        {
+            map(path, advice);
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& other) noexcept { swap(other); }
+
+        mapped_file& operator=(mapped_file&& other) noexcept
+        {
+            mapped_file{::std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        ~mapped_file() { unmap(); }
+
+        void swap(mapped_file& other) noexcept
+        {
+            ::std::ranges::swap(data_, other.data_);
+            ::std::ranges::swap(size_, other.size_);
+#if !STDSHARP_HAS_MMAP
+            ::std::ranges::swap(buffer_, other.buffer_);
+#endif
+        }
+
+        friend void swap(mapped_file& left, mapped_file& right) noexcept { left.swap(right); }
+
+        [[nodiscard]] const char* data() const noexcept { return data_; }
+
+        [[nodiscard]] ::std::size_t size() const noexcept { return size_; }
+
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] const char* begin() const noexcept { return data_; }
+
+        [[nodiscard]] const char* end() const noexcept { return data_ + size_; }
+
+        [[nodiscard]] ::std::string_view text() const noexcept { return {data_, size_}; }
+
+        [[nodiscard]] ::std::span<const ::std::byte> bytes() const noexcept
+        {
+            return ::std::as_bytes(::std::span{data_, size_});
+        }
+
+        [[nodiscard]] explicit operator ::std::string_view() const noexcept { return text(); }
+    };
+}
+
+#undef STDSHARP_HAS_MMAP
\ No newline at end of file
@@ -20,6 +20,13 @@ namespace stdsharp
         };
     }
 
+    template<typename Pointer, typename SizeType = ::std::size_t>
+    struct allocation_result
+    {
+        Pointer ptr;
+        SizeType count;
+    };
+
     template<typename T>
         requires requires
         {
@@ -99,7 +106,6 @@ namespace stdsharp
                 // clang-format off
                 { t_traits.allocate(alloc, size) } -> ::std::same_as<decltype(p)>;
                 { t_traits.allocate(alloc, size, const_void_p) } -> ::std::same_as<decltype(p)>;
-                // { t_traits.allocate_at_least(alloc, size) } -> ::std::same_as<::std::allocation_result<decltype(p)>>;
                 { t_traits.deallocate(alloc, p, size) };
                 { t_traits.max_size(alloc) } -> ::std::same_as<decltype(size)>;
                 // clang-format on
@@ -149,6 +155,18 @@ namespace stdsharp
         using base::destroy;
         using base::select_on_container_copy_construction;
 
+        // falls back to allocate when the allocator can't report the actual allocated size
+        [[nodiscard]] static constexpr allocation_result<pointer, size_type>
+            allocate_at_least(T& a, const size_type count)
+        {
+            if constexpr(requires { a.allocate_at_least(count); })
+            {
+                const auto [ptr, actual_count] = a.allocate_at_least(count);
+                return {ptr, static_cast<size_type>(actual_count)};
+            }
+            else return {base::allocate(a, count), count};
+        }
+
         template<typename U, typename... Args>
             requires ::std::constructible_from<U, Args...>
         static constexpr void construct(T& a, U* ptr, Args&&... args) //
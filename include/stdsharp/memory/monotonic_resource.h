@@ -0,0 +1,116 @@
+#pragma once
+
+#include <limits>
+#include <span>
+
+#include "resource_allocator.h"
+
+namespace stdsharp
+{
+    // Arena that bumps a pointer through geometrically growing chunks, deallocation is a no-op
+    // and the memory is only reclaimed by release or destruction.
+    class monotonic_resource
+    {
+        struct chunk_header
+        {
+            chunk_header* previous;
+        };
+
+        ::std::span<::std::byte> initial_buffer_;
+        ::std::size_t initial_chunk_size_;
+        ::std::size_t next_chunk_size_ = initial_chunk_size_;
+        chunk_header* chunks_ = nullptr;
+        void* current_ = initial_buffer_.data();
+        ::std::size_t remaining_ = initial_buffer_.size();
+
+        static constexpr auto max_chunk_size =
+            ::std::numeric_limits<::std::size_t>::max() - sizeof(chunk_header);
+
+        [[nodiscard]] static constexpr ::std::size_t grown(const ::std::size_t size) noexcept
+        {
+            return size > max_chunk_size / growth_factor ? max_chunk_size : size * growth_factor;
+        }
+
+        void grow(const ::std::size_t size, const ::std::size_t alignment)
+        {
+            if(alignment > max_chunk_size || size > max_chunk_size - alignment)
+                throw ::std::bad_alloc{};
+
+            // the growth is only kept if the chunk is allocated
+            auto chunk_size = next_chunk_size_;
+
+            while(chunk_size < size + alignment) chunk_size = grown(chunk_size);
+
+            auto* const chunk =
+                static_cast<::std::byte*>(::operator new(sizeof(chunk_header) + chunk_size));
+
+            chunks_ = ::new(chunk) chunk_header{chunks_};
+            current_ = chunk + sizeof(chunk_header);
+            remaining_ = chunk_size;
+            next_chunk_size_ = grown(chunk_size);
+        }
+
+    public:
+        static constexpr ::std::size_t default_chunk_size = 1024;
+        static constexpr ::std::size_t growth_factor = 2;
+
+        monotonic_resource() noexcept: monotonic_resource(default_chunk_size) {}
+
+        explicit monotonic_resource(const ::std::size_t initial_chunk_size) noexcept:
+            initial_chunk_size_(::std::max(initial_chunk_size, ::std::size_t{1}))
+        {
+        }
+
+        // the buffer is used before any chunk is allocated
+        explicit monotonic_resource(
+            const ::std::span<::std::byte> buffer,
+            const ::std::size_t initial_chunk_size = default_chunk_size //
+        ) noexcept:
+            initial_buffer_(buffer),
+            initial_chunk_size_(::std::max(initial_chunk_size, ::std::size_t{1}))
+        {
+        }
+
+        monotonic_resource(const monotonic_resource&) = delete;
+        monotonic_resource(monotonic_resource&&) = delete;
+        monotonic_resource& operator=(const monotonic_resource&) = delete;
+        monotonic_resource& operator=(monotonic_resource&&) = delete;
+
+        ~monotonic_resource() { release(); }
+
+        [[nodiscard]] void* allocate(
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        )
+        {
+            if(::std::align(alignment, size, current_, remaining_) == nullptr)
+            {
+                grow(size, alignment);
+                ::std::align(alignment, size, current_, remaining_);
+            }
+
+            void* const ptr = current_;
+            current_ = static_cast<::std::byte*>(current_) + size;
+            remaining_ -= size;
+            return ptr;
+        }
+
+        static constexpr void deallocate(void*, const ::std::size_t, const ::std::size_t) noexcept
+        {
+        }
+
+        // frees every chunk and restarts from the initial buffer
+        void release() noexcept
+        {
+            while(chunks_ != nullptr)
+                ::operator delete(::std::exchange(chunks_, chunks_->previous));
+
+            next_chunk_size_ = initial_chunk_size_;
+            current_ = initial_buffer_.data();
+            remaining_ = initial_buffer_.size();
+        }
+    };
+
+    template<typename T>
+    using monotonic_allocator = resource_allocator<T, monotonic_resource>;
+}
\ No newline at end of file
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+#include "resource_allocator.h"
+#include "../cstdint/cstdint.h"
+#include "../new/new.h"
+
+namespace stdsharp
+{
+    namespace details
+    {
+        // Power of two block size classes, requests larger than MaxBlockSize or over-aligned
+        // beyond it go to the global operator new.
+        template<::std::size_t MaxBlockSize>
+            requires(::std::has_single_bit(MaxBlockSize) && MaxBlockSize >= sizeof(void*))
+        struct pool_size_classes
+        {
+            static constexpr ::std::size_t min_block_size = sizeof(void*);
+
+            static constexpr ::std::size_t class_count =
+                ::std::countr_zero(MaxBlockSize) - ::std::countr_zero(min_block_size) + 1;
+
+            static constexpr ::std::size_t initial_chunk_blocks = 64;
+
+            [[nodiscard]] static constexpr bool
+                pooled(const ::std::size_t size, const ::std::size_t alignment) noexcept
+            {
+                return ::std::max(size, alignment) <= MaxBlockSize;
+            }
+
+            [[nodiscard]] static constexpr ::std::size_t
+                class_of(const ::std::size_t size, const ::std::size_t alignment) noexcept
+            {
+                const auto block_size = ::std::max({size, alignment, min_block_size});
+
+                return ::std::countr_zero(::std::bit_ceil(block_size)) -
+                    ::std::countr_zero(min_block_size);
+            }
+
+            [[nodiscard]] static constexpr ::std::size_t block_size(const ::std::size_t c) noexcept
+            {
+                return min_block_size << c;
+            }
+
+            // the whole block is usable by the caller
+            [[nodiscard]] static constexpr ::std::size_t
+                usable_size(const ::std::size_t size, const ::std::size_t alignment) noexcept
+            {
+                return pooled(size, alignment) ? block_size(class_of(size, alignment)) : size;
+            }
+
+            [[nodiscard]] static void* upstream_allocate(
+                const ::std::size_t size,
+                const ::std::size_t alignment //
+            )
+            {
+                return ::operator new(size, ::std::align_val_t{alignment});
+            }
+
+            static void upstream_deallocate(void* const ptr, const ::std::size_t alignment) noexcept
+            {
+                ::operator delete(ptr, ::std::align_val_t{alignment});
+            }
+        };
+    }
+
+    // Unsynchronized fixed-size-block pool, every size class keeps a free list threaded through
+    // the released blocks and carves new blocks from geometrically growing chunks. Give each
+    // thread its own instance, e.g. a thread_local one, to avoid any synchronization.
+    template<::std::size_t MaxBlockSize = 512>
+    class pool_resource
+    {
+        using classes = details::pool_size_classes<MaxBlockSize>;
+
+        struct chunk_header
+        {
+            chunk_header* previous;
+            ::std::size_t alignment;
+        };
+
+        struct pool
+        {
+            void* free = nullptr;
+            ::std::byte* current = nullptr;
+            ::std::byte* end = nullptr;
+            ::std::size_t next_chunk_blocks = classes::initial_chunk_blocks;
+        };
+
+        ::std::array<pool, classes::class_count> pools_{};
+        chunk_header* chunks_ = nullptr;
+
+        void refill(pool& p, const ::std::size_t block_size)
+        {
+            // the header takes up whole blocks to keep the following blocks aligned
+            const auto header_size =
+                (sizeof(chunk_header) + block_size - 1) / block_size * block_size;
+            const auto alignment = ::std::max(block_size, alignof(chunk_header));
+            const auto chunk_size = header_size + p.next_chunk_blocks * block_size;
+            auto* const chunk =
+                static_cast<::std::byte*>(classes::upstream_allocate(chunk_size, alignment));
+
+            chunks_ = ::new(chunk) chunk_header{chunks_, alignment};
+            p.current = chunk + header_size;
+            p.end = p.current + p.next_chunk_blocks * block_size;
+            p.next_chunk_blocks *= 2;
+        }
+
+    public:
+        static constexpr auto max_block_size = MaxBlockSize;
+
+        pool_resource() = default;
+        pool_resource(const pool_resource&) = delete;
+        pool_resource(pool_resource&&) = delete;
+        pool_resource& operator=(const pool_resource&) = delete;
+        pool_resource& operator=(pool_resource&&) = delete;
+
+        ~pool_resource() { release(); }
+
+        [[nodiscard]] void* allocate(
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        )
+        {
+            if(!classes::pooled(size, alignment))
+                return classes::upstream_allocate(size, alignment);
+
+            const auto c = classes::class_of(size, alignment);
+            auto& p = pools_[c];
+
+            if(p.free != nullptr)
+            {
+                void* const block = p.free;
+                ::std::memcpy(static_cast<void*>(&p.free), block, sizeof(void*));
+                return block;
+            }
+
+            const auto block_size = classes::block_size(c);
+
+            if(p.current == p.end) refill(p, block_size);
+
+            return ::std::exchange(p.current, p.current + block_size);
+        }
+
+        [[nodiscard]] allocation_result<void*> allocate_at_least(
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        )
+        {
+            const auto usable = classes::usable_size(size, alignment);
+            return {allocate(usable, alignment), usable};
+        }
+
+        void deallocate(
+            void* const ptr,
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        ) noexcept
+        {
+            if(!classes::pooled(size, alignment))
+            {
+                classes::upstream_deallocate(ptr, alignment);
+                return;
+            }
+
+            auto& p = pools_[classes::class_of(size, alignment)];
+
+            ::std::memcpy(ptr, static_cast<const void*>(&p.free), sizeof(void*));
+            p.free = ptr;
+        }
+
+        // returns every chunk to the global operator delete
+        void release() noexcept
+        {
+            while(chunks_ != nullptr)
+            {
+                const auto [previous, alignment] = *chunks_;
+                classes::upstream_deallocate(chunks_, alignment);
+                chunks_ = previous;
+            }
+
+            pools_ = {};
+        }
+    };
+
+    // Lock-free fixed-size-block pool shared between threads. Blocks are addressed by 32-bit
+    // indices so every free list head packs the index with an ABA tag into a single 64-bit
+    // atomic. The free list links are atomics stored after the blocks of each chunk, so a pop
+    // racing with the new owner of a block never reads the block itself. Chunks are only
+    // returned to operator delete when the resource is destroyed.
+    template<::std::size_t MaxBlockSize = 512>
+    class concurrent_pool_resource
+    {
+        using classes = details::pool_size_classes<MaxBlockSize>;
+
+        static constexpr auto initial_chunk_blocks = classes::initial_chunk_blocks;
+
+        // enough chunks to address every 32-bit index
+        static constexpr auto chunk_count = 33 - ::std::countr_zero(initial_chunk_blocks);
+
+        static constexpr u64 index_mask = 0xffff'ffff;
+
+        struct alignas(hardware_destructive_interference_size) pool
+        {
+            // tag in the high half, block index + 1 in the low half, 0 index for empty list
+            ::std::atomic<u64> free{0};
+            ::std::atomic<u32> next_fresh{0};
+            ::std::array<::std::atomic<::std::byte*>, chunk_count> chunks{};
+        };
+
+        ::std::array<pool, classes::class_count> pools_{};
+
+        [[nodiscard]] static constexpr ::std::size_t chunk_of(const u32 index) noexcept
+        {
+            return ::std::bit_width(index / initial_chunk_blocks + 1) - 1;
+        }
+
+        [[nodiscard]] static constexpr ::std::size_t
+            chunk_first_index(const ::std::size_t chunk) noexcept
+        {
+            return initial_chunk_blocks * ((::std::size_t{1} << chunk) - 1);
+        }
+
+        [[nodiscard]] static constexpr ::std::size_t
+            chunk_blocks(const ::std::size_t chunk) noexcept
+        {
+            return initial_chunk_blocks << chunk;
+        }
+
+        [[nodiscard]] static ::std::byte*
+            block_at(const pool& p, const ::std::size_t block_size, const u32 index) noexcept
+        {
+            const auto chunk = chunk_of(index);
+            return p.chunks[chunk].load(::std::memory_order_acquire) +
+                (index - chunk_first_index(chunk)) * block_size;
+        }
+
+        [[nodiscard]] static ::std::atomic<u32>*
+            links_of(::std::byte* const chunk_begin, const ::std::size_t size) noexcept
+        {
+            auto* const links = reinterpret_cast<::std::atomic<u32>*>(chunk_begin + size); // NOLINT
+            return ::std::launder(links);
+        }
+
+        [[nodiscard]] static ::std::atomic<u32>&
+            next_of(const pool& p, const ::std::size_t block_size, const u32 index) noexcept
+        {
+            const auto chunk = chunk_of(index);
+
+            return links_of(
+                p.chunks[chunk].load(::std::memory_order_acquire),
+                chunk_blocks(chunk) * block_size
+            )[index - chunk_first_index(chunk)];
+        }
+
+        // the block must be allocated from the pool
+        [[nodiscard]] static u32 index_of(
+            const pool& p,
+            const ::std::size_t block_size,
+            const ::std::byte* const block //
+        ) noexcept
+        {
+            for(::std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+            {
+                const auto* const begin = p.chunks[chunk].load(::std::memory_order_acquire);
+
+                if(begin == nullptr) continue;
+
+                const auto* const end = begin + chunk_blocks(chunk) * block_size; // NOLINT
+
+                if(::std::less_equal<>{}(begin, block) && ::std::less<>{}(block, end))
+                    return static_cast<u32>(
+                        chunk_first_index(chunk) + (block - begin) / block_size
+                    );
+            }
+
+            assert(false && "block isn't allocated from the pool"); // NOLINT
+            return 0;
+        }
+
+        // the chunk may be allocated by several threads at once, the losers free their copy
+        static void ensure_chunk(pool& p, const ::std::size_t block_size, const ::std::size_t chunk)
+        {
+            auto& slot = p.chunks[chunk];
+
+            if(slot.load(::std::memory_order_acquire) != nullptr) return;
+
+            const auto blocks = chunk_blocks(chunk);
+            const auto size = blocks * block_size;
+            auto* allocated = static_cast<::std::byte*>(
+                classes::upstream_allocate(size + blocks * sizeof(::std::atomic<u32>), block_size)
+            );
+
+            auto* const links = reinterpret_cast<::std::atomic<u32>*>(allocated + size); // NOLINT
+            for(::std::size_t i = 0; i < blocks; ++i) ::std::construct_at(links + i, 0);
+
+            if(::std::byte* expected = nullptr; !slot.compare_exchange_strong(
+                   expected,
+                   allocated,
+                   ::std::memory_order_acq_rel //
+               ))
+                classes::upstream_deallocate(allocated, block_size);
+        }
+
+    public:
+        static constexpr auto max_block_size = MaxBlockSize;
+
+        concurrent_pool_resource() = default;
+        concurrent_pool_resource(const concurrent_pool_resource&) = delete;
+        concurrent_pool_resource(concurrent_pool_resource&&) = delete;
+        concurrent_pool_resource& operator=(const concurrent_pool_resource&) = delete;
+        concurrent_pool_resource& operator=(concurrent_pool_resource&&) = delete;
+
+        ~concurrent_pool_resource()
+        {
+            for(::std::size_t c = 0; c < pools_.size(); ++c)
+                for(auto& chunk : pools_[c].chunks)
+                    if(auto* const ptr = chunk.load(::std::memory_order_relaxed); ptr != nullptr)
+                        classes::upstream_deallocate(ptr, classes::block_size(c));
+        }
+
+        [[nodiscard]] void* allocate(
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        )
+        {
+            if(!classes::pooled(size, alignment))
+                return classes::upstream_allocate(size, alignment);
+
+            const auto c = classes::class_of(size, alignment);
+            const auto block_size = classes::block_size(c);
+            auto& p = pools_[c];
+
+            for(auto head = p.free.load(::std::memory_order_acquire); (head & index_mask) != 0;)
+            {
+                const auto index = static_cast<u32>(head - 1);
+
+                // may read the link of a block already handed out again, then the tag makes the
+                // CAS fail
+                const u64 next = next_of(p, block_size, index).load(::std::memory_order_relaxed);
+
+                if(p.free.compare_exchange_weak(
+                       head,
+                       ((head >> 32) + 1) << 32 | next,
+                       ::std::memory_order_acquire //
+                   ))
+                    return block_at(p, block_size, index);
+            }
+
+            const auto index = p.next_fresh.fetch_add(1, ::std::memory_order_relaxed);
+
+            if(index == index_mask) throw ::std::bad_alloc{};
+
+            ensure_chunk(p, block_size, chunk_of(index));
+
+            return block_at(p, block_size, index);
+        }
+
+        [[nodiscard]] allocation_result<void*> allocate_at_least(
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        )
+        {
+            const auto usable = classes::usable_size(size, alignment);
+            return {allocate(usable, alignment), usable};
+        }
+
+        void deallocate(
+            void* const ptr,
+            const ::std::size_t size,
+            const ::std::size_t alignment = alignof(::std::max_align_t) //
+        ) noexcept
+        {
+            if(!classes::pooled(size, alignment))
+            {
+                classes::upstream_deallocate(ptr, alignment);
+                return;
+            }
+
+            const auto c = classes::class_of(size, alignment);
+            const auto block_size = classes::block_size(c);
+            auto& p = pools_[c];
+            const auto index = index_of(p, block_size, static_cast<::std::byte*>(ptr));
+            auto& next = next_of(p, block_size, index);
+            auto head = p.free.load(::std::memory_order_relaxed);
+
+            do next.store(static_cast<u32>(head & index_mask), ::std::memory_order_relaxed);
+            while(!p.free.compare_exchange_weak(
+                head,
+                ((head >> 32) + 1) << 32 | (u64{index} + 1),
+                ::std::memory_order_release,
+                ::std::memory_order_relaxed //
+            ));
+        }
+    };
+
+    template<typename T, ::std::size_t MaxBlockSize = 512>
+    using pool_allocator = resource_allocator<T, pool_resource<MaxBlockSize>>;
+
+    template<typename T, ::std::size_t MaxBlockSize = 512>
+    using concurrent_pool_allocator =
+        resource_allocator<T, concurrent_pool_resource<MaxBlockSize>>;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <limits>
+#include <new>
+
+#include "memory.h"
+
+namespace stdsharp
+{
+    template<typename T>
+    concept memory_resource_req = requires(T& resource, void* ptr, ::std::size_t size)
+    { // clang-format off
+        { resource.allocate(size, size) } -> ::std::same_as<void*>;
+        resource.deallocate(ptr, size, size); // clang-format on
+    };
+
+    // Allocator referring to a non-owning memory resource. Copy assigned containers keep their
+    // own resource while moved and swapped containers take the resource with their elements.
+    template<typename T, memory_resource_req Resource>
+    class resource_allocator
+    {
+        Resource* resource_;
+
+        [[nodiscard]] static constexpr ::std::size_t bytes_of(const ::std::size_t n)
+        {
+            if(n > ::std::numeric_limits<::std::size_t>::max() / sizeof(T))
+                throw ::std::bad_array_new_length{};
+
+            return n * sizeof(T);
+        }
+
+    public:
+        using value_type = T;
+        using resource_type = Resource;
+        using propagate_on_container_copy_assignment = ::std::false_type;
+        using propagate_on_container_move_assignment = ::std::true_type;
+        using propagate_on_container_swap = ::std::true_type;
+        using is_always_equal = ::std::false_type;
+
+        constexpr explicit resource_allocator(Resource& resource) noexcept: resource_(&resource) {}
+
+        template<typename U>
+        constexpr resource_allocator(const resource_allocator<U, Resource>& other) noexcept:
+            resource_(other.resource())
+        {
+        }
+
+        [[nodiscard]] T* allocate(const ::std::size_t n)
+        {
+            return static_cast<T*>(resource_->allocate(bytes_of(n), alignof(T)));
+        }
+
+        [[nodiscard]] allocation_result<T*> allocate_at_least(const ::std::size_t n)
+            requires requires(Resource& r, ::std::size_t size) { r.allocate_at_least(size, size); }
+        {
+            const auto [ptr, size] = resource_->allocate_at_least(bytes_of(n), alignof(T));
+            return {static_cast<T*>(ptr), size / sizeof(T)};
+        }
+
+        void deallocate(T* const ptr, const ::std::size_t n) noexcept
+        {
+            resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+        }
+
+        [[nodiscard]] constexpr Resource* resource() const noexcept { return resource_; }
+
+        template<typename U>
+        [[nodiscard]] constexpr bool
+            operator==(const resource_allocator<U, Resource>& other) const noexcept
+        {
+            return resource_ == other.resource();
+        }
+    };
+}
\ No newline at end of file
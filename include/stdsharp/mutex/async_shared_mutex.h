@@ -0,0 +1,260 @@
+#pragma once
+
+#include <coroutine>
+#include <functional>
+#include <semaphore>
+
+#include "spin_mutex.h"
+
+namespace stdsharp
+{
+    inline constexpr struct inline_executor_fn
+    {
+        void operator()(const ::std::coroutine_handle<> handle) const { handle.resume(); }
+    } inline_executor{};
+
+    // Shared mutex that queues contended lockers in FIFO order instead of parking them. The
+    // releasing thread hands the lock over to the queued waiters, so a coroutine awaiting
+    // async_lock/async_lock_shared is resumed with the lock already held, either inline on the
+    // releasing thread or through the supplied executor.
+    class async_shared_mutex
+    {
+        class waiter
+        {
+            friend class async_shared_mutex;
+
+            waiter* next_ = nullptr;
+            bool shared_;
+            void (*resume_)(waiter&) noexcept;
+
+        protected:
+            constexpr waiter(const bool shared, void (*resume)(waiter&) noexcept) noexcept:
+                shared_(shared), resume_(resume)
+            {
+            }
+        };
+
+        class sync_waiter : waiter
+        {
+            friend class async_shared_mutex;
+
+            ::std::binary_semaphore granted_{0};
+
+            explicit sync_waiter(const bool shared) noexcept:
+                waiter(
+                    shared,
+                    [](waiter& w) noexcept { static_cast<sync_waiter&>(w).granted_.release(); } //
+                )
+            {
+            }
+        };
+
+    public:
+        template<bool Shared, ::std::invocable<::std::coroutine_handle<>> Executor>
+        class lock_awaitable : waiter
+        {
+            friend class async_shared_mutex;
+
+            async_shared_mutex* mutex_;
+            [[no_unique_address]] Executor executor_;
+            ::std::coroutine_handle<> handle_{};
+
+            static void resume_handle(waiter& w) noexcept
+            {
+                auto& self = static_cast<lock_awaitable&>(w);
+
+                // the awaitable lives in the frame the executor resumes and may be gone before
+                // the executor returns
+                auto executor = ::std::move(self.executor_);
+                const auto handle = self.handle_;
+
+                ::std::invoke(executor, handle);
+            }
+
+            lock_awaitable(async_shared_mutex& mutex, Executor executor):
+                waiter(Shared, resume_handle), mutex_(&mutex), executor_(::std::move(executor))
+            {
+            }
+
+        public:
+            [[nodiscard]] bool await_ready() const noexcept
+            {
+                return Shared ? mutex_->try_lock_shared() : mutex_->try_lock();
+            }
+
+            [[nodiscard]] bool await_suspend(const ::std::coroutine_handle<> handle) noexcept
+            {
+                handle_ = handle;
+                return mutex_->enqueue(*this);
+            }
+
+            constexpr void await_resume() const noexcept {}
+        };
+
+    private:
+        spin_mutex state_mutex_;
+        ::std::ptrdiff_t state_ = 0; // -1 if exclusively locked, otherwise the reader count
+        waiter* head_ = nullptr;
+        waiter* tail_ = nullptr;
+
+        [[nodiscard]] bool acquirable(const bool shared) const noexcept
+        {
+            return head_ == nullptr && (shared ? state_ >= 0 : state_ == 0);
+        }
+
+        void acquire(const bool shared) noexcept { state_ = shared ? state_ + 1 : -1; }
+
+        [[nodiscard]] bool try_acquire(const bool shared) noexcept
+        {
+            const ::std::unique_lock lock{state_mutex_};
+
+            if(!acquirable(shared)) return false;
+
+            acquire(shared);
+            return true;
+        }
+
+        // returns false if the lock is acquired instead of queuing the waiter
+        [[nodiscard]] bool enqueue(waiter& w) noexcept
+        {
+            const ::std::unique_lock lock{state_mutex_};
+
+            if(acquirable(w.shared_))
+            {
+                acquire(w.shared_);
+                return false;
+            }
+
+            (tail_ == nullptr ? head_ : tail_->next_) = &w;
+            tail_ = &w;
+            return true;
+        }
+
+        // pops the front waiters that can take the lock over, state_mutex_ must be held
+        [[nodiscard]] waiter* grant() noexcept
+        {
+            waiter* const first = head_;
+            waiter* last = nullptr;
+
+            for(; head_ != nullptr && (head_->shared_ ? state_ >= 0 : state_ == 0);
+                head_ = head_->next_)
+            {
+                acquire(head_->shared_);
+                last = head_;
+            }
+
+            if(last == nullptr) return nullptr;
+
+            last->next_ = nullptr;
+            if(head_ == nullptr) tail_ = nullptr;
+
+            return first;
+        }
+
+        // granted waiters of every mutex waiting to be resumed by the current thread, a waiter
+        // resumed inline that unlocks again appends to it instead of resuming the next one in
+        // its own frame, so handing the lock down a long queue doesn't grow the stack
+        struct resume_queue
+        {
+            waiter* head = nullptr;
+            waiter* tail = nullptr;
+            bool running = false;
+        };
+
+        [[nodiscard]] static resume_queue& pending() noexcept
+        {
+            static thread_local resume_queue queue;
+            return queue;
+        }
+
+        static void drain(resume_queue& queue) noexcept
+        {
+            while(queue.head != nullptr)
+            {
+                // the waiter may be destroyed once resumed
+                auto* const w = queue.head;
+
+                queue.head = w->next_;
+                if(queue.head == nullptr) queue.tail = nullptr;
+
+                w->resume_(*w);
+            }
+        }
+
+        static void resume(waiter* const w) noexcept
+        {
+            if(w == nullptr) return;
+
+            auto& queue = pending();
+
+            (queue.tail == nullptr ? queue.head : queue.tail->next_) = w;
+            for(queue.tail = w; queue.tail->next_ != nullptr; queue.tail = queue.tail->next_);
+
+            if(queue.running) return;
+
+            queue.running = true;
+            drain(queue);
+            queue.running = false;
+        }
+
+        void lock_impl(const bool shared) noexcept
+        {
+            sync_waiter w{shared};
+
+            if(!enqueue(w)) return;
+
+            // the current holder may be deferred on this thread
+            drain(pending());
+            w.granted_.acquire();
+        }
+
+    public:
+        async_shared_mutex() = default;
+        async_shared_mutex(const async_shared_mutex&) = delete;
+        async_shared_mutex(async_shared_mutex&&) = delete;
+        async_shared_mutex& operator=(const async_shared_mutex&) = delete;
+        async_shared_mutex& operator=(async_shared_mutex&&) = delete;
+        ~async_shared_mutex() = default;
+
+        void lock() noexcept { lock_impl(false); }
+
+        [[nodiscard]] bool try_lock() noexcept { return try_acquire(false); }
+
+        void unlock() noexcept
+        {
+            waiter* granted = nullptr;
+            {
+                const ::std::unique_lock lock{state_mutex_};
+                state_ = 0;
+                granted = grant();
+            }
+            resume(granted);
+        }
+
+        void lock_shared() noexcept { lock_impl(true); }
+
+        [[nodiscard]] bool try_lock_shared() noexcept { return try_acquire(true); }
+
+        void unlock_shared() noexcept
+        {
+            waiter* granted = nullptr;
+            {
+                const ::std::unique_lock lock{state_mutex_};
+                if(--state_ == 0) granted = grant();
+            }
+            resume(granted);
+        }
+
+        template<::std::invocable<::std::coroutine_handle<>> Executor = inline_executor_fn>
+        [[nodiscard]] auto async_lock(Executor executor = {})
+        {
+            return lock_awaitable<false, Executor>{*this, ::std::move(executor)};
+        }
+
+        template<::std::invocable<::std::coroutine_handle<>> Executor = inline_executor_fn>
+        [[nodiscard]] auto async_lock_shared(Executor executor = {})
+        {
+            return lock_awaitable<true, Executor>{*this, ::std::move(executor)};
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "spin_mutex.h"
+
+namespace stdsharp
+{
+    // Spins with backoff for a short while, then parks the thread on the lock word through
+    // ::std::atomic::wait, which is futex based on Linux.
+    class hybrid_mutex
+    {
+        enum class state : u32
+        {
+            unlocked,
+            locked,
+            contended
+        };
+
+        ::std::atomic<state> state_{state::unlocked};
+
+        bool try_lock_spinning() noexcept
+        {
+            for(exponential_backoff backoff; backoff.spinning(); backoff())
+                if(try_lock()) return true;
+            return false;
+        }
+
+    public:
+        hybrid_mutex() = default;
+        hybrid_mutex(const hybrid_mutex&) = delete;
+        hybrid_mutex(hybrid_mutex&&) = delete;
+        hybrid_mutex& operator=(const hybrid_mutex&) = delete;
+        hybrid_mutex& operator=(hybrid_mutex&&) = delete;
+        ~hybrid_mutex() = default;
+
+        void lock() noexcept
+        {
+            if(try_lock_spinning()) return;
+
+            while(state_.exchange(state::contended, ::std::memory_order_acquire) != state::unlocked)
+                state_.wait(state::contended, ::std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            auto expected = state::unlocked;
+            return state_.compare_exchange_strong(
+                expected,
+                state::locked,
+                ::std::memory_order_acquire,
+                ::std::memory_order_relaxed //
+            );
+        }
+
+        void unlock() noexcept
+        {
+            if(state_.exchange(state::unlocked, ::std::memory_order_release) == state::contended)
+                state_.notify_one();
+        }
+    };
+}
\ No newline at end of file
@@ -55,12 +55,23 @@ namespace stdsharp::concepts
 
     template<typename T>
     concept shared_mutex = mutex<T> && shared_lockable<T> && requires(T t)
-    {
-        t.try_unlock_shared(); // clang-format off
+    { // clang-format off
         { t.lock_shared() } -> ::std::same_as<void>;
         { t.unlock_shared() } -> ::std::same_as<void>; // clang-format on
     };
 
+    template<typename T, typename... Executor>
+    concept async_lockable = basic_lockable<T> && requires(T t, Executor... executor)
+    {
+        t.async_lock(executor...);
+    };
+
+    template<typename T, typename... Executor>
+    concept async_shared_lockable = shared_lockable<T> && requires(T t, Executor... executor)
+    {
+        t.async_lock_shared(executor...);
+    };
+
     template<typename T>
     concept shared_timed_mutex = timed_mutex<T> && shared_mutex<T> && shared_timed_lockable<T>;
 }
\ No newline at end of file
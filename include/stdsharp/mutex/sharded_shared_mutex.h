@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include "mutex.h"
+#include "../new/new.h"
+
+namespace stdsharp
+{
+    namespace details
+    {
+        inline ::std::size_t current_thread_shard_index() noexcept
+        {
+            static ::std::atomic_size_t next{0};
+            static thread_local const auto index = next.fetch_add(1, ::std::memory_order_relaxed);
+            return index;
+        }
+    }
+
+    // Reader counters are spread over cache line aligned shards, a reader only touches the shard
+    // assigned to the current thread while a writer sweeps all of them.
+    template<::std::size_t ShardCount = 64>
+        requires(ShardCount > 0)
+    class sharded_shared_mutex
+    {
+        struct alignas(hardware_destructive_interference_size) shard
+        {
+            ::std::atomic_size_t readers{0};
+        };
+
+        ::std::array<shard, ShardCount> shards_{};
+
+        alignas(hardware_destructive_interference_size) ::std::atomic_bool writing_{false};
+
+        [[nodiscard]] auto& current_shard() noexcept
+        {
+            return shards_[details::current_thread_shard_index() % ShardCount].readers;
+        }
+
+        [[nodiscard]] bool readers_drained() const noexcept
+        {
+            for(const auto& s : shards_)
+                if(s.readers.load() != 0) return false;
+            return true;
+        }
+
+    public:
+        static constexpr auto shard_count = ShardCount;
+
+        sharded_shared_mutex() = default;
+        sharded_shared_mutex(const sharded_shared_mutex&) = delete;
+        sharded_shared_mutex(sharded_shared_mutex&&) = delete;
+        sharded_shared_mutex& operator=(const sharded_shared_mutex&) = delete;
+        sharded_shared_mutex& operator=(sharded_shared_mutex&&) = delete;
+        ~sharded_shared_mutex() = default;
+
+        void lock() noexcept
+        {
+            while(writing_.exchange(true)) writing_.wait(true, ::std::memory_order_relaxed);
+
+            while(!readers_drained()) ::std::this_thread::yield();
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            if(writing_.exchange(true)) return false;
+
+            if(readers_drained()) return true;
+
+            unlock();
+            return false;
+        }
+
+        void unlock() noexcept
+        {
+            writing_.store(false, ::std::memory_order_release);
+            writing_.notify_all();
+        }
+
+        void lock_shared() noexcept
+        {
+            while(!try_lock_shared()) writing_.wait(true, ::std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool try_lock_shared() noexcept
+        {
+            auto& readers = current_shard();
+
+            readers.fetch_add(1);
+
+            if(!writing_.load()) return true;
+
+            readers.fetch_sub(1, ::std::memory_order_release);
+            return false;
+        }
+
+        void unlock_shared() noexcept
+        {
+            current_shard().fetch_sub(1, ::std::memory_order_release); //
+        }
+    };
+}
\ No newline at end of file
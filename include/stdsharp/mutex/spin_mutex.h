@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
+#include "mutex.h"
+#include "../cstdint/cstdint.h"
+
+namespace stdsharp
+{
+    inline constexpr struct
+    {
+        void operator()() const noexcept
+        {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+            _mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            __asm__ __volatile__("yield");
+#endif
+        }
+    } cpu_relax{};
+
+    class exponential_backoff
+    {
+        u32 count_ = 1;
+
+    public:
+        static constexpr u32 max_spin_count = 1024;
+
+        void operator()() noexcept
+        {
+            if(count_ > max_spin_count)
+            {
+                ::std::this_thread::yield();
+                return;
+            }
+
+            for(auto i = count_; i != 0; --i) cpu_relax();
+
+            count_ *= 2;
+        }
+
+        [[nodiscard]] constexpr bool spinning() const noexcept { return count_ <= max_spin_count; }
+
+        constexpr void reset() noexcept { count_ = 1; }
+    };
+
+    // Test and test-and-set lock, the lock word is only written when it was observed unlocked.
+    class spin_mutex
+    {
+        ::std::atomic_bool locked_{false};
+
+    public:
+        spin_mutex() = default;
+        spin_mutex(const spin_mutex&) = delete;
+        spin_mutex(spin_mutex&&) = delete;
+        spin_mutex& operator=(const spin_mutex&) = delete;
+        spin_mutex& operator=(spin_mutex&&) = delete;
+        ~spin_mutex() = default;
+
+        void lock() noexcept
+        {
+            for(exponential_backoff backoff; !try_lock();)
+                do backoff();
+                while(locked_.load(::std::memory_order_relaxed));
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            return !locked_.load(::std::memory_order_relaxed) &&
+                !locked_.exchange(true, ::std::memory_order_acquire);
+        }
+
+        void unlock() noexcept { locked_.store(false, ::std::memory_order_release); }
+    };
+}
\ No newline at end of file
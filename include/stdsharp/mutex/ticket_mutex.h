@@ -0,0 +1,56 @@
+#pragma once
+
+#include "spin_mutex.h"
+#include "../new/new.h"
+
+namespace stdsharp
+{
+    // First-in first-out spin lock, threads acquire the lock in the order they requested it.
+    class ticket_mutex
+    {
+        alignas(hardware_destructive_interference_size) ::std::atomic<u32> next_{0};
+        alignas(hardware_destructive_interference_size) ::std::atomic<u32> serving_{0};
+
+    public:
+        ticket_mutex() = default;
+        ticket_mutex(const ticket_mutex&) = delete;
+        ticket_mutex(ticket_mutex&&) = delete;
+        ticket_mutex& operator=(const ticket_mutex&) = delete;
+        ticket_mutex& operator=(ticket_mutex&&) = delete;
+        ~ticket_mutex() = default;
+
+        void lock() noexcept
+        {
+            const auto ticket = next_.fetch_add(1, ::std::memory_order_relaxed);
+
+            for(auto serving = serving_.load(::std::memory_order_acquire); serving != ticket;
+                serving = serving_.load(::std::memory_order_acquire))
+            {
+                // back off proportionally to the queue position ahead of this ticket
+                for(auto i = ticket - serving; i != 0; --i) cpu_relax();
+
+                if(ticket - serving > 1) ::std::this_thread::yield();
+            }
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            auto serving = serving_.load(::std::memory_order_acquire);
+
+            return next_.compare_exchange_strong(
+                serving,
+                serving + 1,
+                ::std::memory_order_acquire,
+                ::std::memory_order_relaxed //
+            );
+        }
+
+        void unlock() noexcept
+        {
+            serving_.store(
+                serving_.load(::std::memory_order_relaxed) + 1,
+                ::std::memory_order_release //
+            );
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "spin_mutex.h"
+
+namespace stdsharp
+{
+    // Reader-writer lock where a waiting writer blocks newly arriving readers, so a steady stream
+    // of readers cannot starve writers. The lock owner bit, the waiting writer count and the
+    // reader count share one word, which lets every waiter park on it through ::std::atomic::wait.
+    class writer_preferring_shared_mutex
+    {
+        static constexpr u32 reader_mask = 0xffff;
+        static constexpr u32 waiting_writer = reader_mask + 1;
+        static constexpr u32 writer_locked = 1u << 31;
+        static constexpr u32 waiting_writer_mask = writer_locked - waiting_writer;
+
+        ::std::atomic<u32> state_{0};
+
+        template<typename Predicate, typename Transform>
+        void wait_and_transform(Predicate predicate, Transform transform) noexcept
+        {
+            exponential_backoff backoff;
+
+            for(auto state = state_.load(::std::memory_order_relaxed);;)
+            {
+                if(predicate(state))
+                {
+                    if(state_.compare_exchange_weak(
+                           state,
+                           transform(state),
+                           ::std::memory_order_acquire,
+                           ::std::memory_order_relaxed
+                       ))
+                        return;
+                    continue;
+                }
+
+                if(backoff.spinning()) backoff();
+                else
+                    state_.wait(state, ::std::memory_order_relaxed);
+
+                state = state_.load(::std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        writer_preferring_shared_mutex() = default;
+        writer_preferring_shared_mutex(const writer_preferring_shared_mutex&) = delete;
+        writer_preferring_shared_mutex(writer_preferring_shared_mutex&&) = delete;
+        writer_preferring_shared_mutex& operator=(const writer_preferring_shared_mutex&) = delete;
+        writer_preferring_shared_mutex& operator=(writer_preferring_shared_mutex&&) = delete;
+        ~writer_preferring_shared_mutex() = default;
+
+        void lock() noexcept
+        {
+            if(try_lock()) return;
+
+            state_.fetch_add(waiting_writer, ::std::memory_order_relaxed);
+
+            wait_and_transform(
+                [](const u32 state) noexcept
+                {
+                    return (state & (writer_locked | reader_mask)) == 0; //
+                },
+                [](const u32 state) noexcept { return state - waiting_writer + writer_locked; } //
+            );
+        }
+
+        [[nodiscard]] bool try_lock() noexcept
+        {
+            auto state = state_.load(::std::memory_order_relaxed);
+
+            return (state & (writer_locked | reader_mask)) == 0 &&
+                state_.compare_exchange_strong(
+                    state,
+                    state | writer_locked,
+                    ::std::memory_order_acquire,
+                    ::std::memory_order_relaxed //
+                );
+        }
+
+        void unlock() noexcept
+        {
+            state_.fetch_and(~writer_locked, ::std::memory_order_release);
+            state_.notify_all();
+        }
+
+        void lock_shared() noexcept
+        {
+            wait_and_transform(
+                [](const u32 state) noexcept
+                {
+                    return (state & (writer_locked | waiting_writer_mask)) == 0 &&
+                        (state & reader_mask) != reader_mask;
+                },
+                [](const u32 state) noexcept { return state + 1; } //
+            );
+        }
+
+        [[nodiscard]] bool try_lock_shared() noexcept
+        {
+            auto state = state_.load(::std::memory_order_relaxed);
+
+            while((state & (writer_locked | waiting_writer_mask)) == 0 &&
+                  (state & reader_mask) != reader_mask)
+                if(state_.compare_exchange_weak(
+                       state,
+                       state + 1,
+                       ::std::memory_order_acquire,
+                       ::std::memory_order_relaxed
+                   ))
+                    return true;
+
+            return false;
+        }
+
+        void unlock_shared() noexcept
+        {
+            const auto state = state_.fetch_sub(1, ::std::memory_order_release) - 1;
+
+            if((state & reader_mask) == 0 && (state & waiting_writer_mask) != 0)
+                state_.notify_all();
+        }
+    };
+}
\ No newline at end of file
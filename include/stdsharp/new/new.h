@@ -0,0 +1,13 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+
+namespace stdsharp
+{
+    // ::std::hardware_destructive_interference_size is not available on every standard library
+    // and is ABI unstable on the ones that have it, so a fixed cache line size is used instead.
+    inline constexpr ::std::size_t hardware_destructive_interference_size = 64;
+
+    inline constexpr ::std::size_t hardware_constructive_interference_size = 64;
+}
\ No newline at end of file
@@ -0,0 +1,641 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <memory>
+#include <span>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#include "random.h"
+
+namespace stdsharp
+{
+    namespace details
+    {
+#if defined(__AVX2__)
+        struct random_lane_ops
+        {
+            using vec = __m256i;
+
+            static constexpr ::std::size_t width = 4;
+
+            [[nodiscard]] static vec load(const ::std::uint64_t* const p) noexcept
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); // NOLINT
+            }
+
+            static void store(::std::uint64_t* const p, const vec v) noexcept
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); // NOLINT
+            }
+
+            [[nodiscard]] static vec add(const vec l, const vec r) noexcept
+            {
+                return _mm256_add_epi64(l, r);
+            }
+
+            [[nodiscard]] static vec xor_(const vec l, const vec r) noexcept
+            {
+                return _mm256_xor_si256(l, r);
+            }
+
+            [[nodiscard]] static vec or_(const vec l, const vec r) noexcept
+            {
+                return _mm256_or_si256(l, r);
+            }
+
+            template<int N>
+            [[nodiscard]] static vec shl(const vec v) noexcept
+            {
+                return _mm256_slli_epi64(v, N);
+            }
+
+            template<int N>
+            [[nodiscard]] static vec shr(const vec v) noexcept
+            {
+                return _mm256_srli_epi64(v, N);
+            }
+        };
+#elif defined(__SSE2__)
+        struct random_lane_ops
+        {
+            using vec = __m128i;
+
+            static constexpr ::std::size_t width = 2;
+
+            [[nodiscard]] static vec load(const ::std::uint64_t* const p) noexcept
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); // NOLINT
+            }
+
+            static void store(::std::uint64_t* const p, const vec v) noexcept
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); // NOLINT
+            }
+
+            [[nodiscard]] static vec add(const vec l, const vec r) noexcept
+            {
+                return _mm_add_epi64(l, r);
+            }
+
+            [[nodiscard]] static vec xor_(const vec l, const vec r) noexcept
+            {
+                return _mm_xor_si128(l, r);
+            }
+
+            [[nodiscard]] static vec or_(const vec l, const vec r) noexcept
+            {
+                return _mm_or_si128(l, r);
+            }
+
+            template<int N>
+            [[nodiscard]] static vec shl(const vec v) noexcept
+            {
+                return _mm_slli_epi64(v, N);
+            }
+
+            template<int N>
+            [[nodiscard]] static vec shr(const vec v) noexcept
+            {
+                return _mm_srli_epi64(v, N);
+            }
+        };
+#else
+        struct random_lane_ops
+        {
+            using vec = ::std::uint64_t;
+
+            static constexpr ::std::size_t width = 1;
+
+            [[nodiscard]] static vec load(const ::std::uint64_t* const p) noexcept { return *p; }
+
+            static void store(::std::uint64_t* const p, const vec v) noexcept { *p = v; }
+
+            [[nodiscard]] static vec add(const vec l, const vec r) noexcept { return l + r; }
+
+            [[nodiscard]] static vec xor_(const vec l, const vec r) noexcept { return l ^ r; }
+
+            [[nodiscard]] static vec or_(const vec l, const vec r) noexcept { return l | r; }
+
+            template<int N>
+            [[nodiscard]] static vec shl(const vec v) noexcept
+            {
+                return v << N;
+            }
+
+            template<int N>
+            [[nodiscard]] static vec shr(const vec v) noexcept
+            {
+                return v >> N;
+            }
+        };
+#endif
+    }
+
+    // four xoshiro256** streams a jump() apart, stepped together in SIMD lanes, draws interleave
+    // the lanes and fill() produces the same sequence as repeated calls
+    class xoshiro256starstar_x4
+    {
+    public:
+        using result_type = ::std::uint64_t;
+
+        static constexpr ::std::size_t lanes = 4;
+
+    private:
+        using ops = details::random_lane_ops;
+
+        // structure of arrays, state_[i][lane]
+        ::std::array<::std::array<result_type, lanes>, 4> state_{};
+        ::std::array<result_type, lanes> buffer_{};
+        ::std::size_t index_ = lanes;
+
+        void step(result_type* const out) noexcept
+        {
+            for(::std::size_t lane = 0; lane < lanes; lane += ops::width)
+            {
+                auto s0 = ops::load(&state_[0][lane]);
+                auto s1 = ops::load(&state_[1][lane]);
+                auto s2 = ops::load(&state_[2][lane]);
+                auto s3 = ops::load(&state_[3][lane]);
+
+                // rotl(s1 * 5, 7) * 9 with shifts and adds, there is no 64 bit SIMD multiply
+                const auto times_5 = ops::add(s1, ops::shl<2>(s1));
+                const auto rotated = ops::or_(ops::shl<7>(times_5), ops::shr<57>(times_5));
+                const auto t = ops::shl<17>(s1);
+
+                ops::store(out + lane, ops::add(rotated, ops::shl<3>(rotated)));
+
+                s2 = ops::xor_(s2, s0);
+                s3 = ops::xor_(s3, s1);
+                s1 = ops::xor_(s1, s2);
+                s0 = ops::xor_(s0, s3);
+                s2 = ops::xor_(s2, t);
+                s3 = ops::or_(ops::shl<45>(s3), ops::shr<19>(s3));
+
+                ops::store(&state_[0][lane], s0);
+                ops::store(&state_[1][lane], s1);
+                ops::store(&state_[2][lane], s2);
+                ops::store(&state_[3][lane], s3);
+            }
+        }
+
+    public:
+        xoshiro256starstar_x4() noexcept: xoshiro256starstar_x4(xoshiro256starstar::default_seed)
+        {
+        }
+
+        explicit xoshiro256starstar_x4(const result_type seed) noexcept { this->seed(seed); }
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+
+        [[nodiscard]] static constexpr result_type max() noexcept
+        {
+            return ::std::numeric_limits<result_type>::max();
+        }
+
+        void seed(const result_type seed) noexcept
+        {
+            xoshiro256starstar engine{seed};
+
+            for(::std::size_t lane = 0; lane < lanes; ++lane, engine.jump())
+                for(::std::size_t i = 0; i < 4; ++i) state_[i][lane] = engine.state()[i];
+
+            index_ = lanes;
+        }
+
+        result_type operator()() noexcept
+        {
+            if(index_ == lanes)
+            {
+                step(buffer_.data());
+                index_ = 0;
+            }
+
+            return buffer_[index_++];
+        }
+
+        void fill(const ::std::span<result_type> out) noexcept
+        {
+            auto it = out.begin();
+
+            for(; index_ != lanes && it != out.end(); ++it) *it = buffer_[index_++];
+
+            for(; out.end() - it >= static_cast<::std::ptrdiff_t>(lanes); it += lanes)
+                step(::std::to_address(it));
+
+            for(; it != out.end(); ++it) *it = (*this)();
+        }
+
+        void discard(unsigned long long n) noexcept
+        {
+            for(; n != 0; --n) (*this)();
+        }
+
+        // consumed draws left in the buffer don't matter
+        [[nodiscard]] friend bool
+            operator==(const xoshiro256starstar_x4& l, const xoshiro256starstar_x4& r) noexcept
+        {
+            return l.state_ == r.state_ && l.index_ == r.index_ &&
+                ::std::ranges::equal(
+                    ::std::span{l.buffer_}.subspan(l.index_),
+                    ::std::span{r.buffer_}.subspan(r.index_)
+                );
+        }
+    };
+
+    namespace details
+    {
+        template<typename Gen>
+        [[nodiscard]] ::std::uint64_t random_word(Gen& gen)
+        {
+            constexpr auto range = static_cast<::std::uint64_t>(Gen::max() - Gen::min());
+
+            if constexpr(range == ::std::numeric_limits<::std::uint64_t>::max())
+                return static_cast<::std::uint64_t>(gen() - Gen::min());
+            else if constexpr(range == ::std::numeric_limits<::std::uint32_t>::max())
+            {
+                const auto high = static_cast<::std::uint64_t>(gen() - Gen::min());
+                return high << 32 | static_cast<::std::uint64_t>(gen() - Gen::min());
+            }
+            else
+            {
+                ::std::uniform_int_distribution<::std::uint64_t> dist;
+                return dist(gen);
+            }
+        }
+
+        template<typename Gen>
+        void random_words(Gen& gen, const ::std::span<::std::uint64_t> out)
+        {
+            if constexpr(requires { gen.fill(out); }) gen.fill(out);
+            else
+                for(auto& word : out) word = random_word(gen);
+        }
+
+        // random words are generated in bulk in chunks of this size
+        inline constexpr ::std::size_t random_chunk_size = 64;
+
+        // 32 bit values use each half of a word, Lemire's multiply and shift with a rejection
+        // threshold computed once
+        template<typename T, typename Gen>
+        void fill_uniform_int(const ::std::span<T> out, const T min, const T max, Gen& gen)
+        {
+            using unsigned_t = ::std::make_unsigned_t<T>;
+
+            ::std::array<::std::uint64_t, random_chunk_size> words{};
+
+            if constexpr(sizeof(T) <= 4)
+            {
+                const auto range = static_cast<::std::uint32_t>(
+                    static_cast<::std::uint32_t>(static_cast<unsigned_t>(
+                        static_cast<unsigned_t>(max) - static_cast<unsigned_t>(min)
+                    )) +
+                    1
+                );
+                const auto threshold =
+                    range == 0 ? 0 : static_cast<::std::uint32_t>(-range) % range;
+                const auto map = [&](::std::uint32_t x)
+                {
+                    if(range == 0) return static_cast<T>(x);
+
+                    auto product = static_cast<::std::uint64_t>(x) * range;
+
+                    while(static_cast<::std::uint32_t>(product) < threshold)
+                    {
+                        x = static_cast<::std::uint32_t>(random_word(gen));
+                        product = static_cast<::std::uint64_t>(x) * range;
+                    }
+
+                    return static_cast<T>(
+                        static_cast<unsigned_t>(min) + static_cast<unsigned_t>(product >> 32)
+                    );
+                };
+
+                for(::std::size_t i = 0; i < out.size(); i += 2 * words.size())
+                {
+                    const auto count = ::std::min(out.size() - i, 2 * words.size());
+                    const ::std::span chunk{words.data(), (count + 1) / 2};
+
+                    random_words(gen, chunk);
+
+                    for(::std::size_t j = 0; j < count; ++j)
+                        out[i + j] = map(static_cast<::std::uint32_t>(chunk[j / 2] >> j % 2 * 32));
+                }
+            }
+            else
+            {
+                const auto range = static_cast<::std::uint64_t>(
+                    static_cast<::std::uint64_t>(max) - static_cast<::std::uint64_t>(min) + 1
+                );
+                const auto threshold = range == 0 ? 0 : (0 - range) % range;
+                const auto map = [&](::std::uint64_t x)
+                {
+                    if(range == 0) return static_cast<T>(x);
+
+                    auto product = uint128{0, x} * uint128{0, range};
+
+                    while(product.low < threshold)
+                    {
+                        x = random_word(gen);
+                        product = uint128{0, x} * uint128{0, range};
+                    }
+
+                    return static_cast<T>(static_cast<::std::uint64_t>(min) + product.high);
+                };
+
+                for(::std::size_t i = 0; i < out.size(); i += words.size())
+                {
+                    const ::std::span chunk{words.data(), ::std::min(out.size() - i, words.size())};
+
+                    random_words(gen, chunk);
+
+                    for(::std::size_t j = 0; j < chunk.size(); ++j) out[i + j] = map(chunk[j]);
+                }
+            }
+        }
+
+        // the mantissa is filled with random bits under the exponent of 1, giving [1, 2)
+        [[nodiscard]] inline double to_unit_double(const ::std::uint64_t word) noexcept
+        {
+            return ::std::bit_cast<double>(word >> 12 | 0x3FF0'0000'0000'0000) - 1;
+        }
+
+        [[nodiscard]] inline float to_unit_float(const ::std::uint32_t word) noexcept
+        {
+            return ::std::bit_cast<float>(word >> 9 | 0x3F80'0000) - 1;
+        }
+
+        inline void to_uniform_real(
+            const ::std::uint64_t* const words,
+            double* const out,
+            const ::std::size_t size,
+            const double min,
+            const double scale
+        ) noexcept
+        {
+            ::std::size_t i = 0;
+
+#if defined(__AVX2__)
+            for(; i + 4 <= size; i += 4)
+            {
+                const auto word =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)); // NOLINT
+                const auto bits = _mm256_or_si256(
+                    _mm256_srli_epi64(word, 12),
+                    _mm256_set1_epi64x(0x3FF0'0000'0000'0000)
+                );
+                const auto unit = _mm256_sub_pd(_mm256_castsi256_pd(bits), _mm256_set1_pd(1));
+
+                _mm256_storeu_pd(
+                    out + i,
+                    _mm256_add_pd(_mm256_mul_pd(unit, _mm256_set1_pd(scale)), _mm256_set1_pd(min))
+                );
+            }
+#elif defined(__SSE2__)
+            for(; i + 2 <= size; i += 2)
+            {
+                const auto word =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i)); // NOLINT
+                const auto bits =
+                    _mm_or_si128(_mm_srli_epi64(word, 12), _mm_set1_epi64x(0x3FF0'0000'0000'0000));
+                const auto unit = _mm_sub_pd(_mm_castsi128_pd(bits), _mm_set1_pd(1));
+
+                _mm_storeu_pd(
+                    out + i,
+                    _mm_add_pd(_mm_mul_pd(unit, _mm_set1_pd(scale)), _mm_set1_pd(min))
+                );
+            }
+#endif
+
+            for(; i < size; ++i) out[i] = min + to_unit_double(words[i]) * scale;
+        }
+
+        // two floats per word
+        inline void to_uniform_real(
+            const ::std::uint64_t* const words,
+            float* const out,
+            const ::std::size_t size,
+            const float min,
+            const float scale
+        ) noexcept
+        {
+            ::std::size_t i = 0;
+
+#if defined(__AVX2__)
+            for(; i + 8 <= size; i += 8)
+            {
+                const auto word =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i / 2)); // NOLINT
+                const auto bits =
+                    _mm256_or_si256(_mm256_srli_epi32(word, 9), _mm256_set1_epi32(0x3F80'0000));
+                const auto unit = _mm256_sub_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(1));
+
+                _mm256_storeu_ps(
+                    out + i,
+                    _mm256_add_ps(_mm256_mul_ps(unit, _mm256_set1_ps(scale)), _mm256_set1_ps(min))
+                );
+            }
+#elif defined(__SSE2__)
+            for(; i + 4 <= size; i += 4)
+            {
+                const auto word =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i / 2)); // NOLINT
+                const auto bits =
+                    _mm_or_si128(_mm_srli_epi32(word, 9), _mm_set1_epi32(0x3F80'0000));
+                const auto unit = _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1));
+
+                _mm_storeu_ps(
+                    out + i,
+                    _mm_add_ps(_mm_mul_ps(unit, _mm_set1_ps(scale)), _mm_set1_ps(min))
+                );
+            }
+#endif
+
+            for(; i < size; ++i)
+                out[i] = min +
+                    to_unit_float(static_cast<::std::uint32_t>(words[i / 2] >> i % 2 * 32)) * scale;
+        }
+
+        template<typename T, typename Gen>
+        void fill_uniform_real(const ::std::span<T> out, const T min, const T max, Gen& gen)
+        {
+            constexpr auto per_word = sizeof(::std::uint64_t) / sizeof(T);
+
+            ::std::array<::std::uint64_t, random_chunk_size> words{};
+
+            for(::std::size_t i = 0; i < out.size(); i += per_word * words.size())
+            {
+                const auto count = ::std::min(out.size() - i, per_word * words.size());
+
+                random_words(gen, ::std::span{words.data(), (count + per_word - 1) / per_word});
+                to_uniform_real(words.data(), out.data() + i, count, min, max - min);
+            }
+        }
+
+        // Marsaglia and Tsang's ziggurat with 128 layers, the layer index and the value take
+        // separate bits of a word
+        class normal_ziggurat
+        {
+            static constexpr ::std::size_t layers = 128;
+            static constexpr double r = 3.442619855899;
+            static constexpr double area = 9.91256303526217e-3;
+            static constexpr double scale = 2147483648.0;
+
+            ::std::array<::std::uint32_t, layers> k_{};
+            ::std::array<double, layers> w_{};
+            ::std::array<double, layers> f_{};
+
+            normal_ziggurat()
+            {
+                const auto q = area / ::std::exp(-0.5 * r * r);
+                auto d = r;
+                auto t = r;
+
+                k_[0] = static_cast<::std::uint32_t>(d / q * scale);
+                k_[1] = 0;
+                w_[0] = q / scale;
+                w_[layers - 1] = d / scale;
+                f_[0] = 1;
+                f_[layers - 1] = ::std::exp(-0.5 * d * d);
+
+                for(auto i = layers - 2; i >= 1; --i)
+                {
+                    d = ::std::sqrt(-2 * ::std::log(area / d + ::std::exp(-0.5 * d * d)));
+                    k_[i + 1] = static_cast<::std::uint32_t>(d / t * scale);
+                    t = d;
+                    f_[i] = ::std::exp(-0.5 * d * d);
+                    w_[i] = d / scale;
+                }
+            }
+
+            template<typename Gen>
+            [[nodiscard]] static double uniform(Gen& gen)
+            {
+                // (0, 1] for the logarithms
+                return 1 - to_unit_double(random_word(gen));
+            }
+
+            template<typename Gen>
+            [[nodiscard]] double slow(::std::uint64_t word, Gen& gen) const
+            {
+                while(true)
+                {
+                    const auto value = static_cast<::std::int32_t>(word >> 32);
+                    const auto layer = word & (layers - 1);
+                    const auto x = value * w_[layer];
+
+                    if(::std::abs(static_cast<::std::int64_t>(value)) < k_[layer]) return x;
+
+                    if(layer == 0)
+                    {
+                        double tail_x = 0;
+                        double tail_y = 0;
+
+                        do // NOLINT(*-avoid-do-while)
+                        {
+                            tail_x = -::std::log(uniform(gen)) / r;
+                            tail_y = -::std::log(uniform(gen));
+                        } while(tail_y + tail_y < tail_x * tail_x);
+
+                        return value > 0 ? r + tail_x : -r - tail_x;
+                    }
+
+                    if(f_[layer] + uniform(gen) * (f_[layer - 1] - f_[layer]) <
+                       ::std::exp(-0.5 * x * x))
+                        return x;
+
+                    word = random_word(gen);
+                }
+            }
+
+        public:
+            [[nodiscard]] static const normal_ziggurat& get()
+            {
+                static const normal_ziggurat instance;
+                return instance;
+            }
+
+            template<typename Gen>
+            [[nodiscard]] double operator()(const ::std::uint64_t word, Gen& gen) const
+            {
+                const auto value = static_cast<::std::int32_t>(word >> 32);
+                const auto layer = word & (layers - 1);
+
+                if(::std::abs(static_cast<::std::int64_t>(value)) < k_[layer])
+                    return value * w_[layer];
+
+                return slow(word, gen);
+            }
+        };
+
+        template<typename T, typename Gen>
+        void fill_normal(const ::std::span<T> out, const T mean, const T stddev, Gen& gen)
+        {
+            const auto& ziggurat = normal_ziggurat::get();
+
+            ::std::array<::std::uint64_t, random_chunk_size> words{};
+
+            for(::std::size_t i = 0; i < out.size(); i += words.size())
+            {
+                const ::std::span chunk{words.data(), ::std::min(out.size() - i, words.size())};
+
+                random_words(gen, chunk);
+
+                for(::std::size_t j = 0; j < chunk.size(); ++j)
+                    out[i + j] = static_cast<T>(mean + stddev * ziggurat(chunk[j], gen));
+            }
+        }
+    }
+
+    // integers in [min, max] and reals in [min, max), engines with a fill() member such as
+    // xoshiro256starstar_x4 generate their bits in bulk
+    inline constexpr struct fill_uniform_fn
+    {
+        template<::std::integral T, ::std::uniform_random_bit_generator Gen>
+            requires(!::std::same_as<T, bool>)
+        void operator()(
+            const ::std::span<T> out,
+            const ::std::type_identity_t<T> min,
+            const ::std::type_identity_t<T> max,
+            Gen& gen
+        ) const
+        {
+            details::fill_uniform_int(out, min, max, gen);
+        }
+
+        template<::std::floating_point T, ::std::uniform_random_bit_generator Gen>
+            requires(::std::same_as<T, float> || ::std::same_as<T, double>)
+        void operator()(
+            const ::std::span<T> out,
+            const ::std::type_identity_t<T> min,
+            const ::std::type_identity_t<T> max,
+            Gen& gen
+        ) const
+        {
+            details::fill_uniform_real(out, min, max, gen);
+        }
+    } fill_uniform{};
+
+    inline constexpr struct fill_normal_fn
+    {
+        template<::std::floating_point T, ::std::uniform_random_bit_generator Gen>
+        void operator()(
+            const ::std::span<T> out,
+            const ::std::type_identity_t<T> mean,
+            const ::std::type_identity_t<T> stddev,
+            Gen& gen
+        ) const
+        {
+            details::fill_normal(out, mean, stddev, gen);
+        }
+    } fill_normal{};
+}
\ No newline at end of file
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
 #include <random>
 
 namespace stdsharp
@@ -14,4 +18,290 @@ namespace stdsharp
             return random_device;
         }
     } get_random_device{};
+
+    // Steele, Lea and Flood's SplitMix64, mostly used to expand a seed into generator states
+    class splitmix64
+    {
+        ::std::uint64_t state_ = 0;
+
+    public:
+        using result_type = ::std::uint64_t;
+
+        splitmix64() = default;
+
+        constexpr explicit splitmix64(const result_type seed) noexcept: state_(seed) {}
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+
+        [[nodiscard]] static constexpr result_type max() noexcept
+        {
+            return ::std::numeric_limits<result_type>::max();
+        }
+
+        constexpr void seed(const result_type seed) noexcept { state_ = seed; }
+
+        constexpr result_type operator()() noexcept
+        {
+            auto z = state_ += 0x9E37'79B9'7F4A'7C15;
+
+            z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9;
+            z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EB;
+            return z ^ (z >> 31);
+        }
+
+        constexpr void discard(const unsigned long long n) noexcept
+        {
+            state_ += 0x9E37'79B9'7F4A'7C15 * n;
+        }
+
+        [[nodiscard]] friend constexpr bool
+            operator==(const splitmix64&, const splitmix64&) noexcept = default;
+    };
+
+    // Blackman and Vigna's xoshiro256**, jump() and long_jump() advance by 2^128 and 2^192
+    // draws to split the period into independent streams
+    class xoshiro256starstar
+    {
+        ::std::array<::std::uint64_t, 4> state_{};
+
+        constexpr void jump(const ::std::array<::std::uint64_t, 4>& polynomial) noexcept
+        {
+            ::std::array<::std::uint64_t, 4> state{};
+
+            for(const auto word : polynomial)
+                for(auto bit = 0; bit < 64; ++bit)
+                {
+                    if((word >> bit & 1) != 0)
+                        for(::std::size_t i = 0; i < state.size(); ++i) state[i] ^= state_[i];
+
+                    (*this)();
+                }
+
+            state_ = state;
+        }
+
+    public:
+        using result_type = ::std::uint64_t;
+
+        static constexpr result_type default_seed = 0x853C'49E6'748F'EA9B;
+
+        constexpr xoshiro256starstar() noexcept { seed(default_seed); }
+
+        constexpr explicit xoshiro256starstar(const result_type seed) noexcept
+        {
+            this->seed(seed);
+        }
+
+        // the state must not be all zero
+        constexpr explicit xoshiro256starstar(const ::std::array<result_type, 4>& state) noexcept:
+            state_(state)
+        {
+        }
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+
+        [[nodiscard]] static constexpr result_type max() noexcept
+        {
+            return ::std::numeric_limits<result_type>::max();
+        }
+
+        constexpr void seed(const result_type seed) noexcept
+        {
+            splitmix64 mix{seed};
+            for(auto& s : state_) s = mix();
+        }
+
+        [[nodiscard]] constexpr auto& state() const noexcept { return state_; }
+
+        constexpr result_type operator()() noexcept
+        {
+            auto& [s0, s1, s2, s3] = state_;
+            const auto result = ::std::rotl(s1 * 5, 7) * 9;
+            const auto t = s1 << 17;
+
+            s2 ^= s0;
+            s3 ^= s1;
+            s1 ^= s2;
+            s0 ^= s3;
+            s2 ^= t;
+            s3 = ::std::rotl(s3, 45);
+
+            return result;
+        }
+
+        constexpr void discard(unsigned long long n) noexcept
+        {
+            for(; n != 0; --n) (*this)();
+        }
+
+        constexpr void jump() noexcept
+        {
+            jump({
+                0x180E'C6D3'3CFD'0ABA,
+                0xD5A6'1266'F0C9'392C,
+                0xA958'2618'E03F'C9AA,
+                0x39AB'DC45'29B1'661C //
+            });
+        }
+
+        constexpr void long_jump() noexcept
+        {
+            jump({
+                0x76E1'5D3E'FEFD'CBBF,
+                0xC500'4E44'1C52'2FB3,
+                0x7771'0069'854E'E241,
+                0x3910'9BB0'2ACB'E635 //
+            });
+        }
+
+        [[nodiscard]] friend constexpr bool
+            operator==(const xoshiro256starstar&, const xoshiro256starstar&) noexcept = default;
+    };
+
+    namespace details
+    {
+        struct uint128
+        {
+            ::std::uint64_t high;
+            ::std::uint64_t low;
+
+            [[nodiscard]] friend constexpr uint128
+                operator+(const uint128 l, const uint128 r) noexcept
+            {
+                const auto low = l.low + r.low;
+                return {l.high + r.high + (low < l.low ? 1 : 0), low};
+            }
+
+            [[nodiscard]] friend constexpr uint128
+                operator*(const uint128 l, const uint128 r) noexcept
+            {
+                const auto cross = l.high * r.low + l.low * r.high;
+
+#if defined(__SIZEOF_INT128__)
+                __extension__ typedef unsigned __int128 wide; // NOLINT(*-use-using)
+
+                const auto product = static_cast<wide>(l.low) * r.low;
+
+                return {
+                    static_cast<::std::uint64_t>(product >> 64) + cross,
+                    static_cast<::std::uint64_t>(product) //
+                };
+#else
+                const auto a_low = l.low & 0xFFFF'FFFF;
+                const auto a_high = l.low >> 32;
+                const auto b_low = r.low & 0xFFFF'FFFF;
+                const auto b_high = r.low >> 32;
+                const auto low_low = a_low * b_low;
+                const auto middle = a_high * b_low + (low_low >> 32);
+                const auto middle2 = a_low * b_high + (middle & 0xFFFF'FFFF);
+
+                return {
+                    a_high * b_high + (middle >> 32) + (middle2 >> 32) + cross,
+                    (middle2 << 32) | (low_low & 0xFFFF'FFFF) //
+                };
+#endif
+            }
+
+            [[nodiscard]] friend constexpr bool
+                operator==(const uint128&, const uint128&) noexcept = default;
+        };
+    }
+
+    // O'Neill's PCG64 (XSL RR 128/64), engines seeded with different streams are independent
+    // and discard() jumps by any distance in logarithmic time
+    class pcg64
+    {
+        using uint128 = details::uint128;
+
+        static constexpr uint128 multiplier{0x2360'ED05'1FC6'5DA4, 0x4385'DF64'9FCC'F645};
+
+        uint128 state_{};
+        uint128 increment_{};
+
+        constexpr void step() noexcept { state_ = state_ * multiplier + increment_; }
+
+    public:
+        using result_type = ::std::uint64_t;
+
+        static constexpr result_type default_seed = 0xCAFE'F00D'D15E'A5E5;
+        static constexpr result_type default_stream = 0xDA3E'39CB'94B9'5BDB;
+
+        constexpr pcg64() noexcept { seed(default_seed); }
+
+        constexpr explicit pcg64(
+            const result_type seed,
+            const result_type stream = default_stream
+        ) noexcept
+        {
+            this->seed(seed, stream);
+        }
+
+        [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+
+        [[nodiscard]] static constexpr result_type max() noexcept
+        {
+            return ::std::numeric_limits<result_type>::max();
+        }
+
+        constexpr void
+            seed(const result_type seed, const result_type stream = default_stream) noexcept
+        {
+            state_ = {};
+            increment_ = {stream >> 63, stream << 1 | 1};
+            step();
+            state_ = state_ + uint128{0, seed};
+            step();
+        }
+
+        constexpr result_type operator()() noexcept
+        {
+            step();
+
+            return ::std::rotr(
+                state_.high ^ state_.low,
+                static_cast<int>(state_.high >> 58) //
+            );
+        }
+
+        // Brown's arbitrary stride LCG jump, logarithmic in n
+        constexpr void discard(unsigned long long n) noexcept
+        {
+            uint128 acc_mult{0, 1};
+            uint128 acc_plus{};
+            auto cur_mult = multiplier;
+            auto cur_plus = increment_;
+
+            for(; n != 0; n >>= 1)
+            {
+                if((n & 1) != 0)
+                {
+                    acc_mult = acc_mult * cur_mult;
+                    acc_plus = acc_plus * cur_mult + cur_plus;
+                }
+
+                cur_plus = (cur_mult + uint128{0, 1}) * cur_plus;
+                cur_mult = cur_mult * cur_mult;
+            }
+
+            state_ = acc_mult * state_ + acc_plus;
+        }
+
+        [[nodiscard]] friend constexpr bool
+            operator==(const pcg64&, const pcg64&) noexcept = default;
+    };
+
+    // thread local xoshiro256** seeded from the random device on first use in each thread
+    inline constexpr struct
+    {
+        [[nodiscard]] auto& operator()() const
+        {
+            static thread_local xoshiro256starstar engine{[]
+            {
+                auto& device = get_random_device();
+                return static_cast<::std::uint64_t>(device()) << 32 | device();
+            }()};
+
+            return engine;
+        }
+    } get_random_engine{};
 }
\ No newline at end of file
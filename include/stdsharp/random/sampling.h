@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cmath>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include "fill.h"
+
+namespace stdsharp
+{
+    namespace details
+    {
+        // high and low halves of word * n, an index in [0, n) and the remaining random bits
+        [[nodiscard]] constexpr uint128 scale_random_word(
+            const ::std::uint64_t word,
+            const ::std::size_t n
+        ) noexcept
+        {
+            return uint128{0, word} * uint128{0, static_cast<::std::uint64_t>(n)};
+        }
+
+        // (0, 1], safe for logarithms
+        template<typename Gen>
+        [[nodiscard]] double random_open_unit(Gen& gen)
+        {
+            return 1 - to_unit_double(random_word(gen));
+        }
+    }
+
+    // Walker's alias method with Vose's linear construction, one random word per sample: the
+    // high half of word * size() picks a column and the low half decides between the column
+    // and its alias
+    class alias_table
+    {
+        ::std::vector<::std::uint64_t> threshold_;
+        ::std::vector<::std::size_t> alias_;
+
+    public:
+        alias_table() = default;
+
+        template<::std::ranges::input_range Range>
+            requires ::std::is_arithmetic_v<::std::ranges::range_value_t<Range>>
+        explicit alias_table(Range&& weights)
+        {
+            ::std::vector<double> probability;
+
+            for(const auto w : weights)
+            {
+                const auto weight = static_cast<double>(w);
+
+                if(!(weight >= 0) || !::std::isfinite(weight))
+                    throw ::std::invalid_argument{
+                        "alias_table weight should be finite and non-negative" //
+                    };
+
+                probability.push_back(weight);
+            }
+
+            const auto size = probability.size();
+            const auto sum = ::std::reduce(probability.cbegin(), probability.cend(), 0.0);
+
+            if(!(sum > 0)) throw ::std::invalid_argument{"alias_table weights sum to zero"};
+
+            ::std::vector<::std::size_t> small;
+            ::std::vector<::std::size_t> large;
+
+            threshold_.resize(size);
+            alias_.resize(size);
+
+            for(::std::size_t i = 0; i < size; ++i)
+            {
+                probability[i] *= static_cast<double>(size) / sum;
+                (probability[i] < 1 ? small : large).push_back(i);
+            }
+
+            // 2^64 as a double, probabilities of 1 and more saturate
+            constexpr auto scale = 18446744073709551616.0;
+
+            const auto set = [&](const ::std::size_t i, const ::std::size_t alias)
+            {
+                const auto p = probability[i] * scale;
+
+                threshold_[i] = p >= scale ? ::std::numeric_limits<::std::uint64_t>::max() :
+                                             static_cast<::std::uint64_t>(p);
+                alias_[i] = alias;
+            };
+
+            while(!small.empty() && !large.empty())
+            {
+                const auto less = small.back();
+                const auto more = large.back();
+
+                small.pop_back();
+                set(less, more);
+
+                probability[more] -= 1 - probability[less];
+
+                if(probability[more] < 1)
+                {
+                    large.pop_back();
+                    small.push_back(more);
+                }
+            }
+
+            // the rest are 1 up to rounding
+            for(const auto i : large) set(i, i);
+            for(const auto i : small)
+            {
+                probability[i] = 1;
+                set(i, i);
+            }
+        }
+
+        alias_table(const ::std::initializer_list<double> weights):
+            alias_table(::std::span{weights.begin(), weights.size()})
+        {
+        }
+
+        [[nodiscard]] ::std::size_t size() const noexcept { return alias_.size(); }
+
+        [[nodiscard]] bool empty() const noexcept { return alias_.empty(); }
+
+        // the table must not be empty
+        template<::std::uniform_random_bit_generator Gen>
+        [[nodiscard]] ::std::size_t operator()(Gen& gen) const
+        {
+            const auto [column, coin] =
+                details::scale_random_word(details::random_word(gen), size());
+
+            return coin < threshold_[column] ? column : alias_[column];
+        }
+    };
+
+    // uniform sample of k elements from a stream of unknown length, Li's algorithm L draws
+    // random numbers only for the elements it keeps and skips the others
+    template<typename T>
+    class reservoir_sampler
+    {
+        ::std::vector<T> reservoir_;
+        ::std::size_t capacity_;
+        ::std::size_t seen_ = 0;
+        ::std::size_t next_ = 0;
+        double w_ = 1;
+
+        template<typename Gen>
+        void skip(Gen& gen)
+        {
+            w_ *= ::std::exp(::std::log(details::random_open_unit(gen)) / capacity_);
+
+            const auto skip =
+                ::std::floor(::std::log(details::random_open_unit(gen)) / ::std::log1p(-w_));
+
+            constexpr auto max = ::std::numeric_limits<::std::size_t>::max();
+
+            next_ = skip < static_cast<double>(max - next_) ?
+                next_ + static_cast<::std::size_t>(skip) + 1 :
+                max;
+        }
+
+        template<typename U, typename Gen>
+        void take(U&& value, Gen& gen)
+        {
+            if(reservoir_.size() < capacity_)
+            {
+                reservoir_.emplace_back(::std::forward<U>(value));
+
+                if(reservoir_.size() == capacity_)
+                {
+                    next_ = capacity_ - 1;
+                    skip(gen);
+                }
+
+                return;
+            }
+
+            const auto [slot, _] = details::scale_random_word(details::random_word(gen), capacity_);
+
+            reservoir_[slot] = ::std::forward<U>(value);
+            skip(gen);
+        }
+
+    public:
+        explicit reservoir_sampler(const ::std::size_t capacity): capacity_(capacity)
+        {
+            if(capacity_ == 0) throw ::std::invalid_argument{"reservoir_sampler capacity is zero"};
+
+            reservoir_.reserve(capacity_);
+        }
+
+        template<typename U, ::std::uniform_random_bit_generator Gen>
+            requires ::std::assignable_from<T&, U> && ::std::constructible_from<T, U>
+        void push(U&& value, Gen& gen)
+        {
+            if(seen_++ == next_ || reservoir_.size() < capacity_)
+                take(::std::forward<U>(value), gen);
+        }
+
+        // random access ranges jump straight to the next kept element
+        template<::std::ranges::input_range Range, ::std::uniform_random_bit_generator Gen>
+        void push_range(Range&& range, Gen& gen)
+        {
+            auto it = ::std::ranges::begin(range);
+            const auto end = ::std::ranges::end(range);
+
+            if constexpr(::std::ranges::random_access_range<Range> &&
+                         ::std::ranges::sized_range<Range>)
+                while(it != end)
+                {
+                    if(reservoir_.size() == capacity_)
+                    {
+                        const auto remaining = static_cast<::std::size_t>(end - it);
+                        const auto skipped = ::std::min(next_ - seen_, remaining);
+
+                        it += static_cast<::std::ranges::range_difference_t<Range>>(skipped);
+                        seen_ += skipped;
+
+                        if(it == end) break;
+                    }
+
+                    push(*it, gen);
+                    ++it;
+                }
+            else
+                for(; it != end; ++it) push(*it, gen);
+        }
+
+        [[nodiscard]] ::std::span<const T> sample() const noexcept { return reservoir_; }
+
+        [[nodiscard]] ::std::size_t capacity() const noexcept { return capacity_; }
+
+        // elements pushed so far
+        [[nodiscard]] ::std::size_t seen() const noexcept { return seen_; }
+    };
+}
\ No newline at end of file
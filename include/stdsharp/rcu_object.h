@@ -0,0 +1,250 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "new/new.h"
+#include "reflection/reflection.h"
+
+namespace stdsharp
+{
+    // Read-copy-update counterpart of concurrent_object. Readers pin the currently published
+    // value wait-free, with one increment of the reader count of the current epoch and one load.
+    // Writers copy the value, modify the copy and publish it, then wait for the readers of the
+    // previous version before reclaiming it.
+    template<typename T>
+    class rcu_object
+    {
+    public:
+        using value_type = ::std::optional<T>;
+
+    private:
+        struct alignas(hardware_destructive_interference_size) reader_count
+        {
+            ::std::atomic_size_t value{0};
+        };
+
+        template<typename Other>
+            requires requires(rcu_object& left)
+            {
+                ::std::declval<rcu_object&>().swap(::std::declval<Other>());
+            }
+        friend void swap(rcu_object& left, Other&& right)
+        {
+            left.swap(::std::forward<Other>(right)); //
+        }
+
+    public:
+        class snapshot_handle
+        {
+            friend class rcu_object;
+
+            const value_type* value_;
+            ::std::atomic_size_t* readers_;
+
+            constexpr snapshot_handle(
+                const value_type* value,
+                ::std::atomic_size_t& readers // clang-format off
+            ) noexcept: value_(value), readers_(&readers) // clang-format on
+            {
+            }
+
+        public:
+            snapshot_handle(const snapshot_handle&) = delete;
+
+            constexpr snapshot_handle(snapshot_handle&& other) noexcept:
+                value_(::std::exchange(other.value_, nullptr)),
+                readers_(::std::exchange(other.readers_, nullptr))
+            {
+            }
+
+            snapshot_handle& operator=(const snapshot_handle&) = delete;
+            snapshot_handle& operator=(snapshot_handle&&) = delete;
+
+            ~snapshot_handle()
+            {
+                if(readers_ != nullptr) readers_->fetch_sub(1, ::std::memory_order_release);
+            }
+
+            [[nodiscard]] constexpr const value_type& operator*() const noexcept { return *value_; }
+
+            [[nodiscard]] constexpr const value_type* operator->() const noexcept { return value_; }
+        };
+
+        rcu_object(): current_(new value_type{}) {}
+
+        template<typename... TArg>
+            requires ::std::constructible_from<T, TArg...>
+        explicit rcu_object(TArg&&... t_arg):
+            current_(new value_type{::std::in_place, ::std::forward<TArg>(t_arg)...})
+        {
+        }
+
+        rcu_object(const rcu_object& other) requires ::std::copy_constructible<value_type> :
+            current_(new value_type{*other.snapshot()})
+        {
+        }
+
+        rcu_object(rcu_object&& other) noexcept(false) requires
+            ::std::move_constructible<value_type> :
+            current_(new value_type{::std::move(*other.current_.load(::std::memory_order_relaxed))})
+        {
+        }
+
+        rcu_object& operator=(const rcu_object& other) //
+            requires ::std::copy_constructible<value_type>
+        {
+            if(this != &other) publish(::std::make_unique<value_type>(*other.snapshot()));
+            return *this;
+        }
+
+        rcu_object& operator=(rcu_object&& other) noexcept(false) requires
+            ::std::move_constructible<value_type>
+        {
+            if(this != &other)
+                publish(
+                    ::std::make_unique<value_type>(
+                        ::std::move(*other.current_.load(::std::memory_order_relaxed)) //
+                    ) //
+                );
+            return *this;
+        }
+
+        ~rcu_object() { delete current_.load(::std::memory_order_relaxed); }
+
+        void swap(rcu_object& other) requires ::std::copy_constructible<value_type>
+        {
+            if(this == &other) return;
+
+            auto value = ::std::make_unique<value_type>(*snapshot());
+            publish(::std::make_unique<value_type>(*other.snapshot()));
+            other.publish(::std::move(value));
+        }
+
+        // a reader registered under an outdated epoch is still waited for by the writers
+        [[nodiscard]] snapshot_handle snapshot() const noexcept
+        {
+            auto& readers = readers_[epoch_.load() % readers_.size()].value;
+
+            readers.fetch_add(1);
+            return {current_.load(), readers};
+        }
+
+        template<::std::invocable<const value_type&> Func>
+        void read(Func&& func) const&
+        {
+            const auto& handle = snapshot();
+            ::std::invoke(func, *handle);
+        }
+
+        template<::std::invocable<const value_type> Func>
+        void read(Func&& func) const&&
+        {
+            ::std::invoke(
+                func,
+                static_cast<const value_type&&>(*current_.load(::std::memory_order_relaxed)) //
+            );
+        }
+
+        template<auto Name>
+            requires(Name == "read"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) const& noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->read(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return this->read(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<auto Name>
+            requires(Name == "read"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) const&& noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->read(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return static_cast<const rcu_object&&>(*this) //
+                    .read(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<::std::invocable<value_type&> Func>
+            requires ::std::copy_constructible<value_type>
+        void write(Func&& func) &
+        {
+            const ::std::unique_lock lock{write_mutex_};
+            auto next =
+                ::std::make_unique<value_type>(*current_.load(::std::memory_order_relaxed));
+
+            ::std::invoke(func, *next);
+            publish_locked(::std::move(next));
+        }
+
+        template<::std::invocable<value_type> Func>
+        void write(Func&& func) &&
+        {
+            ::std::invoke(func, ::std::move(*current_.load(::std::memory_order_relaxed)));
+        }
+
+        template<auto Name>
+            requires(Name == "write"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) & noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->write(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return this->write(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<auto Name>
+            requires(Name == "write"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) && noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { ::std::move(*this).write(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return ::std::move(*this).write(::std::forward<Args>(args)...);
+            };
+        }
+
+    private:
+        void publish(::std::unique_ptr<value_type> next)
+        {
+            const ::std::unique_lock lock{write_mutex_};
+            publish_locked(::std::move(next));
+        }
+
+        void publish_locked(::std::unique_ptr<value_type> next) noexcept
+        {
+            const ::std::unique_ptr<value_type> previous{current_.exchange(next.release())};
+
+            // Every reader of the previous version is registered in one of the counts. Each
+            // count is drained after the epoch moves away from it, so only readers that loaded
+            // the epoch before the flip can still join it.
+            for(::std::size_t i = 0; i < readers_.size(); ++i)
+            {
+                const auto& readers = readers_[epoch_.fetch_add(1) % readers_.size()].value;
+
+                while(readers.load() != 0) ::std::this_thread::yield();
+            }
+        }
+
+        ::std::atomic<value_type*> current_;
+        ::std::atomic_size_t epoch_{0};
+        mutable ::std::array<reader_count, 2> readers_{};
+        ::std::mutex write_mutex_;
+    };
+
+    template<typename T>
+    rcu_object(T&&) -> rcu_object<::std::decay_t<T>>;
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <optional>
+#include <thread>
+
+#include "new/new.h"
+#include "reflection/reflection.h"
+#include "scope.h"
+
+namespace stdsharp
+{
+    // Sequence lock counterpart of concurrent_object for trivially copyable payloads. Readers copy
+    // the value out and retry if a writer was active meanwhile, so they never write to shared
+    // memory.
+    template<typename T>
+        requires concepts::trivial_copyable<::std::optional<T>>
+    class seqlock_object
+    {
+    public:
+        using value_type = ::std::optional<T>;
+
+    private:
+        using word_t = ::std::uintptr_t;
+
+        static constexpr auto word_count =
+            (sizeof(value_type) + sizeof(word_t) - 1) / sizeof(word_t);
+
+        using buffer_t = ::std::array<word_t, word_count>;
+
+        alignas(hardware_destructive_interference_size) ::std::atomic_size_t sequence_{0};
+
+        ::std::array<::std::atomic<word_t>, word_count> words_{};
+
+        void store_words(const value_type& value) noexcept
+        {
+            buffer_t buffer{};
+
+            ::std::memcpy(buffer.data(), &value, sizeof(value_type));
+
+            for(::std::size_t i = 0; i < word_count; ++i)
+                words_[i].store(buffer[i], ::std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] value_type load_words() const noexcept
+        {
+            buffer_t buffer{};
+            value_type value;
+
+            for(::std::size_t i = 0; i < word_count; ++i)
+                buffer[i] = words_[i].load(::std::memory_order_relaxed);
+
+            ::std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(value_type));
+
+            return value;
+        }
+
+        [[nodiscard]] ::std::size_t lock_write() noexcept
+        {
+            auto sequence = sequence_.load(::std::memory_order_relaxed);
+
+            while(
+                sequence % 2 != 0 ||
+                !sequence_.compare_exchange_weak(
+                    sequence,
+                    sequence + 1,
+                    ::std::memory_order_acquire,
+                    ::std::memory_order_relaxed //
+                ) //
+            )
+            {
+                ::std::this_thread::yield();
+                sequence = sequence_.load(::std::memory_order_relaxed);
+            }
+
+            ::std::atomic_thread_fence(::std::memory_order_release);
+
+            return sequence + 1;
+        }
+
+        template<typename Func>
+        void write_impl(Func& func)
+        {
+            const auto sequence = lock_write();
+            const auto unlock = scope::make_scoped<scope::exit_fn_policy::on_exit>( //
+                [this, sequence]() noexcept
+                {
+                    sequence_.store(sequence + 1, ::std::memory_order_release); //
+                } //
+            );
+            auto value = load_words();
+
+            ::std::invoke(func, value);
+            store_words(value);
+        }
+
+    public:
+        seqlock_object() { store_words({}); }
+
+        template<typename... TArg>
+            requires ::std::constructible_from<T, TArg...>
+        explicit seqlock_object(TArg&&... t_arg)
+        {
+            store_words(value_type{::std::in_place, ::std::forward<TArg>(t_arg)...});
+        }
+
+        seqlock_object(const seqlock_object& other) noexcept { store_words(other.load()); }
+
+        seqlock_object(seqlock_object&& other) noexcept: seqlock_object(other) {}
+
+        seqlock_object& operator=(const seqlock_object& other) noexcept
+        {
+            if(this != &other) store(other.load());
+            return *this;
+        }
+
+        seqlock_object& operator=(seqlock_object&& other) noexcept
+        {
+            return *this = other; //
+        }
+
+        ~seqlock_object() = default;
+
+        [[nodiscard]] value_type load() const noexcept
+        {
+            while(true)
+            {
+                const auto sequence = sequence_.load(::std::memory_order_acquire);
+
+                if(sequence % 2 == 0)
+                {
+                    const auto& value = load_words();
+
+                    ::std::atomic_thread_fence(::std::memory_order_acquire);
+
+                    if(sequence_.load(::std::memory_order_relaxed) == sequence) return value;
+                }
+                else
+                    ::std::this_thread::yield();
+            }
+        }
+
+        void store(const value_type& value) noexcept
+        {
+            const auto sequence = lock_write();
+            store_words(value);
+            sequence_.store(sequence + 1, ::std::memory_order_release);
+        }
+
+        template<::std::invocable<const value_type&> Func>
+        void read(Func&& func) const&
+        {
+            ::std::invoke(func, load());
+        }
+
+        template<::std::invocable<const value_type> Func>
+        void read(Func&& func) const&&
+        {
+            ::std::invoke(func, static_cast<const value_type>(load()));
+        }
+
+        template<auto Name>
+            requires(Name == "read"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) const& noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->read(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return this->read(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<auto Name>
+            requires(Name == "read"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) const&& noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->read(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return static_cast<const seqlock_object&&>(*this) //
+                    .read(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<::std::invocable<value_type&> Func>
+        void write(Func&& func) &
+        {
+            write_impl(func);
+        }
+
+        template<::std::invocable<value_type> Func>
+        void write(Func&& func) &&
+        {
+            ::std::invoke(func, load_words());
+        }
+
+        template<auto Name>
+            requires(Name == "write"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) & noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { this->write(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return this->write(::std::forward<Args>(args)...);
+            };
+        }
+
+        template<auto Name>
+            requires(Name == "write"sv)
+        constexpr auto operator()(const reflection::member_t<Name>) && noexcept
+        {
+            return [this]<typename... Args>
+                requires requires { ::std::move(*this).write(::std::declval<Args>()...); }
+            (Args && ... args) //
+            {
+                return ::std::move(*this).write(::std::forward<Args>(args)...);
+            };
+        }
+    };
+
+    template<typename T>
+    seqlock_object(T&&) -> seqlock_object<::std::decay_t<T>>;
+}
\ No newline at end of file
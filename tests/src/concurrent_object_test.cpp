@@ -1,4 +1,5 @@
 #include "stdsharp/concurrent_object.h"
+#include "stdsharp/mutex/async_shared_mutex.h"
 #include "test.h"
 
 SCENARIO("concurrent object", "[concurrent object]") // NOLINT
@@ -22,4 +23,158 @@ SCENARIO("concurrent object", "[concurrent object]") // NOLINT
 
     REQUIRE(assignable<concurrent_object<int>&, concurrent_object<int, my_mutex>>);
     REQUIRE(assignable<concurrent_object<int>&, const concurrent_object<int, my_mutex>&>);
+}
+
+namespace
+{
+    template<typename Object>
+    concept async_writable = requires(Object object)
+    {
+        object.async_write([](optional<int>&) {});
+    };
+
+    struct detached_task
+    {
+        struct promise_type
+        {
+            static constexpr detached_task get_return_object() noexcept { return {}; }
+
+            static constexpr suspend_never initial_suspend() noexcept { return {}; }
+
+            static constexpr suspend_never final_suspend() noexcept { return {}; }
+
+            static constexpr void return_void() noexcept {}
+
+            [[noreturn]] static void unhandled_exception() noexcept { terminate(); }
+        };
+    };
+
+    template<typename... Executor>
+    detached_task
+        increment(concurrent_object<int, async_shared_mutex>& object, Executor... executor)
+    {
+        co_await object.async_write([](optional<int>& v) { ++*v; }, executor...);
+    }
+
+    detached_task
+        read_to(const concurrent_object<int, async_shared_mutex>& object, vector<int>& values)
+    {
+        values.push_back(co_await object.async_read([](const optional<int>& v) { return *v; }));
+    }
+
+    detached_task increment_twice(concurrent_object<int, async_shared_mutex>& object)
+    {
+        co_await object.async_write([](optional<int>& v) { ++*v; });
+        object.write([](optional<int>& v) { ++*v; });
+    }
+}
+
+SCENARIO("concurrent object async access", "[concurrent object]") // NOLINT
+{
+    STATIC_REQUIRE(!async_writable<concurrent_object<int>>);
+    STATIC_REQUIRE(async_writable<concurrent_object<int, async_shared_mutex>>);
+
+    GIVEN("a concurrent object locked by current thread")
+    {
+        concurrent_object<int, async_shared_mutex> object{0};
+        vector<int> values;
+        auto& mutex = const_cast<async_shared_mutex&>(object.lockable()); // NOLINT
+
+        mutex.lock();
+
+        THEN("awaiting coroutines are resumed by unlock in order")
+        {
+            constexpr auto count = 1000;
+
+            for(auto i = 0; i < count; ++i) increment(object);
+            read_to(object, values);
+            increment(object);
+
+            REQUIRE(values.empty());
+
+            mutex.unlock();
+
+            REQUIRE(values == vector{count});
+            object.read([](const optional<int>& v) { REQUIRE(*v == count + 1); });
+        }
+
+        AND_THEN("continuation is resumed by the supplied executor")
+        {
+            vector<coroutine_handle<>> handles;
+
+            increment(object, [&handles](const coroutine_handle<> h) { handles.push_back(h); });
+            mutex.unlock();
+
+            REQUIRE(handles.size() == 1);
+            REQUIRE(!mutex.try_lock_shared());
+
+            handles.front().resume();
+            object.read([](const optional<int>& v) { REQUIRE(*v == 1); });
+        }
+
+        AND_THEN("the executor keeps working after the resumed coroutine finishes")
+        {
+            const auto resumed = make_shared<int>(0);
+
+            increment(
+                object,
+                [resumed](const coroutine_handle<> h)
+                {
+                    h.resume();
+                    ++*resumed;
+                } //
+            );
+            mutex.unlock();
+
+            REQUIRE(*resumed == 1);
+            object.read([](const optional<int>& v) { REQUIRE(*v == 1); });
+        }
+
+        AND_THEN("a deep wait queue is handed over without nesting resumptions")
+        {
+            static constexpr auto count = 100'000;
+
+            for(auto i = 0; i < count; ++i) increment(object);
+
+            mutex.unlock();
+
+            object.read([](const optional<int>& v) { REQUIRE(*v == count); });
+        }
+
+        AND_THEN("a resumed coroutine can lock synchronously behind the waiter it granted")
+        {
+            increment_twice(object);
+            increment(object);
+
+            mutex.unlock();
+
+            object.read([](const optional<int>& v) { REQUIRE(*v == 3); });
+        }
+    }
+
+    GIVEN("coroutines and threads contending the object")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto loop = 1000;
+
+        concurrent_object<int, async_shared_mutex> object{0};
+        vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+            threads.emplace_back(
+                [&object, i]
+                {
+                    for(auto j = 0; j < loop; ++j)
+                        if(i % 2 == 0) increment(object);
+                        else object.write([](optional<int>& v) { ++*v; });
+                } //
+            );
+
+        for(auto& t : threads) t.join();
+
+        THEN("every increment is applied")
+        {
+            object.read([](const optional<int>& v) { REQUIRE(*v == thread_count * loop); });
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <deque>
+#include <numeric>
+
+#include "stdsharp/concurrent_queue.h"
+#include "stdsharp/concurrent_object.h"
+#include "test.h"
+
+SCENARIO("bounded concurrent queue", "[concurrent queue]") // NOLINT
+{
+    GIVEN("a queue with capacity 3")
+    {
+        bounded_concurrent_queue<string> queue{3};
+
+        THEN("capacity is rounded up to power of two")
+        {
+            REQUIRE(queue.capacity() == 4);
+            REQUIRE(queue.empty());
+        }
+
+        AND_THEN("values are popped in pushed order until empty")
+        {
+            REQUIRE(queue.try_push("1"));
+            REQUIRE(queue.try_push("2"));
+            REQUIRE(queue.size() == 2);
+
+            REQUIRE(queue.try_pop() == "1");
+            REQUIRE(queue.pop() == "2");
+            REQUIRE(!queue.try_pop());
+        }
+
+        AND_THEN("push fails when queue is full")
+        {
+            array<string, 5> values{"1", "2", "3", "4", "5"};
+
+            REQUIRE(queue.try_push_n(make_move_iterator(values.begin()), values.size()) == 4);
+            REQUIRE(!queue.try_push("6"));
+
+            vector<string> popped;
+
+            REQUIRE(queue.try_pop_n(back_inserter(popped), 3) == 3);
+            REQUIRE(popped == vector<string>{"1", "2", "3"});
+            REQUIRE(queue.try_push("6"));
+        }
+    }
+
+    GIVEN("multiple producers and consumers")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto loop = 10'000;
+
+        bounded_concurrent_queue<int> queue{64};
+        ::std::atomic<long> sum = 0;
+        ::std::vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&queue]
+                {
+                    for(auto j = 1; j <= loop; ++j) queue.push(j);
+                } //
+            );
+            threads.emplace_back(
+                [&queue, &sum]
+                {
+                    for(auto j = 0; j < loop; ++j) sum += queue.pop();
+                } //
+            );
+        }
+
+        for(auto& t : threads) t.join();
+
+        THEN("every value is consumed exactly once")
+        {
+            REQUIRE(sum == thread_count * (loop * (loop + 1L) / 2));
+            REQUIRE(queue.empty());
+        }
+    }
+
+    GIVEN("producers and consumers moving batches larger than the capacity")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto loop = 10'000;
+        constexpr auto batch = 100;
+
+        bounded_concurrent_queue<int> queue{64};
+        ::std::atomic<long> sum = 0;
+        ::std::vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&queue]
+                {
+                    ::std::vector<int> values(loop);
+
+                    ::std::iota(values.begin(), values.end(), 1);
+
+                    for(auto it = values.cbegin(); it != values.cend(); it += batch)
+                        queue.push_n(it, batch);
+                } //
+            );
+            threads.emplace_back(
+                [&queue, &sum]
+                {
+                    ::std::vector<int> values;
+
+                    for(auto j = 0; j < loop; j += batch / 2)
+                        queue.pop_n(back_inserter(values), batch / 2);
+
+                    sum += ::std::reduce(values.cbegin(), values.cend(), 0L);
+                } //
+            );
+        }
+
+        for(auto& t : threads) t.join();
+
+        THEN("every value is consumed exactly once")
+        {
+            REQUIRE(sum == thread_count * (loop * (loop + 1L) / 2));
+            REQUIRE(queue.empty());
+        }
+    }
+}
+
+namespace
+{
+    constexpr auto item_count = 100'000;
+
+    template<typename Push, typename Pop>
+    void produce_consume(const int producer_count, const int consumer_count, Push push, Pop pop)
+    {
+        ::std::vector<::std::thread> threads;
+        ::std::atomic_int consumed = 0;
+
+        for(auto i = 0; i < producer_count; ++i)
+            threads.emplace_back(
+                [&]
+                {
+                    for(auto j = 0; j < item_count / producer_count; ++j) push(j);
+                } //
+            );
+
+        for(auto i = 0; i < consumer_count; ++i)
+            threads.emplace_back(
+                [&]
+                {
+                    while(consumed.load(::std::memory_order_relaxed) <
+                          item_count / producer_count * producer_count)
+                        if(pop()) ++consumed;
+                } //
+            );
+
+        for(auto& t : threads) t.join();
+    }
+}
+
+SCENARIO("bounded concurrent queue throughput", "[.benchmark][concurrent queue]") // NOLINT
+{
+    for(const auto thread_count : {1, 2, 4, 8, 16})
+    {
+        BENCHMARK(fmt::format("bounded_concurrent_queue {0}P{0}C", thread_count))
+        {
+            bounded_concurrent_queue<int> queue{1024};
+
+            produce_consume(
+                thread_count,
+                thread_count,
+                [&queue](const int v) { queue.push(v); },
+                [&queue] { return queue.try_pop().has_value(); } //
+            );
+        };
+
+        BENCHMARK(fmt::format("concurrent_object<deque> {0}P{0}C", thread_count))
+        {
+            concurrent_object<deque<int>> queue{deque<int>{}};
+
+            produce_consume(
+                thread_count,
+                thread_count,
+                [&queue](const int v)
+                {
+                    queue.write([v](optional<deque<int>>& q) { q->push_back(v); }); //
+                },
+                [&queue]
+                {
+                    bool popped = false;
+
+                    queue.write(
+                        [&popped](optional<deque<int>>& q)
+                        {
+                            if(q->empty()) return;
+                            q->pop_front();
+                            popped = true;
+                        } //
+                    );
+
+                    return popped;
+                } //
+            );
+        };
+    }
+}
\ No newline at end of file
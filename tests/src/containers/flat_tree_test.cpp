@@ -0,0 +1,179 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <map>
+#include <random>
+
+#include "stdsharp/containers/actions.h"
+#include "stdsharp/containers/flat_tree.h"
+#include "test.h"
+
+using namespace containers;
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: flat tree concept",
+    "[containers][flat tree]",
+    int,
+    string //
+)
+{
+    STATIC_REQUIRE(unique_associative_container<flat_set<TestType>>);
+    STATIC_REQUIRE(multikey_associative_container<flat_multiset<TestType>>);
+    STATIC_REQUIRE(unique_associative_container<flat_map<TestType, int>>);
+    STATIC_REQUIRE(multikey_associative_container<flat_multimap<TestType, int>>);
+    STATIC_REQUIRE(reversible_container<flat_map<TestType, int>>);
+}
+
+SCENARIO("flat map", "[containers][flat tree]") // NOLINT
+{
+    GIVEN("a flat map built from an unsorted range")
+    {
+        flat_map<int, string> map{{3, "3"}, {1, "1"}, {2, "2"}, {1, "one"}};
+
+        THEN("values are sorted and the first duplicate wins")
+        {
+            REQUIRE(map.size() == 3);
+            REQUIRE(map.at(1) == "1");
+            REQUIRE(::std::ranges::is_sorted(map.container(), map.value_comp()));
+        }
+
+        AND_THEN("actions emplace and erase by key")
+        {
+            actions::emplace(map, 0, "0");
+            REQUIRE(map.begin()->second == "0");
+
+            REQUIRE(actions::erase(map, 2) == 1);
+            REQUIRE(!map.contains(2));
+        }
+
+        AND_THEN("map accessors")
+        {
+            map[5] = "5";
+            REQUIRE(!map.try_emplace(5, "five").second);
+            REQUIRE(!map.insert_or_assign(5, "five").second);
+            REQUIRE(map.at(5) == "five");
+            REQUIRE_THROWS_AS(map.at(4), out_of_range);
+        }
+
+        AND_THEN("sorted range insertion merges in order")
+        {
+            const vector<pair<int, string>> sorted{{0, "0"}, {2, "two"}, {4, "4"}};
+
+            map.insert(sorted_unique, sorted.cbegin(), sorted.cend());
+
+            REQUIRE(map == flat_map<int, string>{
+                {0, "0"}, {1, "1"}, {2, "2"}, {3, "3"}, {4, "4"} //
+            });
+        }
+
+        AND_THEN("node handle round trip")
+        {
+            auto node = map.extract(1);
+            REQUIRE(node);
+            REQUIRE(node.value().second == "1");
+
+            const auto [position, inserted, left] = map.insert(::std::move(node));
+            REQUIRE(inserted);
+            REQUIRE(position->first == 1);
+            REQUIRE(left.empty());
+        }
+
+        AND_THEN("merge moves absent keys only")
+        {
+            flat_map<int, string> other{{1, "x"}, {7, "7"}};
+
+            map.merge(other);
+
+            REQUIRE(map.size() == 4);
+            REQUIRE(map.at(1) == "1");
+            REQUIRE(other == flat_map<int, string>{{1, "x"}});
+        }
+    }
+
+    GIVEN("a flat map with a transparent comparator")
+    {
+        flat_map<string, int, less<>> map{{"a", 1}, {"b", 2}, {"c", 3}};
+
+        THEN("a mutable iterator erases by position rather than as a key")
+        {
+            REQUIRE(map.erase(map.begin())->first == "b");
+            REQUIRE(map.erase("c"sv) == 1);
+            REQUIRE(map == flat_map<string, int, less<>>{{"b", 2}});
+        }
+    }
+}
+
+SCENARIO("flat multiset", "[containers][flat tree]") // NOLINT
+{
+    GIVEN("a flat multiset with duplicated keys")
+    {
+        flat_multiset<string, less<>> set{"b", "a", "b", "c"};
+
+        THEN("equivalent keys are kept and counted with heterogeneous lookup")
+        {
+            REQUIRE(set.size() == 4);
+            REQUIRE(set.count("b"sv) == 2);
+
+            const auto [first, last] = set.equal_range("b"sv);
+            REQUIRE(last - first == 2);
+
+            REQUIRE(actions::erase(set, "b"s) == 2);
+            REQUIRE(set == flat_multiset<string, less<>>{"a", "c"});
+        }
+
+        AND_THEN("hinted insertion keeps equivalent keys in insertion order")
+        {
+            set.emplace_hint(set.begin(), "a");
+            set.insert(set.end(), "z");
+
+            REQUIRE(set == flat_multiset<string, less<>>{"a", "a", "b", "b", "c", "z"});
+        }
+    }
+}
+
+SCENARIO("flat tree build and lookup", "[.benchmark][containers][flat tree]") // NOLINT
+{
+    constexpr auto count = 10'000;
+
+    vector<int> keys(count);
+    ::std::ranges::generate(
+        keys,
+        [engine = mt19937{}]() mutable { return static_cast<int>(engine()); } //
+    );
+
+    auto sorted_keys = keys;
+    ::std::ranges::sort(sorted_keys);
+    sorted_keys.erase(::std::ranges::unique(sorted_keys).begin(), sorted_keys.end());
+
+    BENCHMARK("std::set build") { return set<int>{keys.cbegin(), keys.cend()}.size(); };
+
+    BENCHMARK("flat_set build") { return flat_set<int>{keys.cbegin(), keys.cend()}.size(); };
+
+    BENCHMARK("flat_set sorted build")
+    {
+        return flat_set<int>{sorted_unique, sorted_keys.cbegin(), sorted_keys.cend()}.size();
+    };
+
+    map<int, int> tree_map;
+    flat_map<int, int> flat;
+
+    flat.reserve(sorted_keys.size());
+    for(const auto k : sorted_keys)
+    {
+        tree_map.emplace_hint(tree_map.end(), k, k);
+        flat.emplace_hint(flat.end(), k, k);
+    }
+
+    BENCHMARK("std::map lookup")
+    {
+        auto sum = 0LL;
+        for(const auto k : keys) sum += tree_map.find(k)->second;
+        return sum;
+    };
+
+    BENCHMARK("flat_map lookup")
+    {
+        auto sum = 0LL;
+        for(const auto k : keys) sum += flat.find(k)->second;
+        return sum;
+    };
+}
\ No newline at end of file
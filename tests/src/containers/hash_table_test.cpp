@@ -0,0 +1,236 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <random>
+#include <unordered_map>
+
+#include "stdsharp/containers/actions.h"
+#include "stdsharp/containers/hash_table.h"
+#include "test.h"
+
+using namespace containers;
+
+namespace
+{
+    struct string_hash
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] size_t operator()(const ::std::string_view str) const
+        {
+            return hash<::std::string_view>{}(str);
+        }
+    };
+
+    using transparent_set = hash_set<string, string_hash, equal_to<>>;
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: hash table concept",
+    "[containers][hash table]",
+    int,
+    string //
+)
+{
+    STATIC_REQUIRE(unique_unordered_associative_container<hash_set<TestType>>);
+    STATIC_REQUIRE(unique_unordered_associative_container<hash_map<TestType, int>>);
+    STATIC_REQUIRE(unique_unordered_associative_container<hash_map<TestType, unique_ptr<int>>>);
+}
+
+SCENARIO("hash map", "[containers][hash table]") // NOLINT
+{
+    GIVEN("a hash map with some values")
+    {
+        hash_map<int, string> map{{3, "3"}, {1, "1"}, {2, "2"}, {1, "one"}};
+
+        THEN("the first duplicate wins")
+        {
+            REQUIRE(map.size() == 3);
+            REQUIRE(map.at(1) == "1");
+            REQUIRE(::std::ranges::distance(map) == 3);
+        }
+
+        AND_THEN("actions emplace and erase by key")
+        {
+            actions::emplace(map, 0, "0");
+            REQUIRE(map.at(0) == "0");
+
+            REQUIRE(actions::erase(map, 2) == 1);
+            REQUIRE(!map.contains(2));
+            REQUIRE(actions::erase(map, 2) == 0);
+        }
+
+        AND_THEN("map accessors")
+        {
+            map[5] = "5";
+            REQUIRE(!map.try_emplace(5, "five").second);
+            REQUIRE(!map.insert_or_assign(5, "five").second);
+            REQUIRE(map.at(5) == "five");
+            REQUIRE_THROWS_AS(map.at(4), out_of_range);
+        }
+
+        AND_THEN("node handle round trip")
+        {
+            auto node = map.extract(1);
+            REQUIRE(node);
+            REQUIRE(!map.contains(1));
+
+            const auto [position, inserted, left] = map.insert(::std::move(node));
+            REQUIRE(inserted);
+            REQUIRE(position->second == "1");
+            REQUIRE(left.empty());
+        }
+
+        AND_THEN("merge moves absent keys only")
+        {
+            hash_map<int, string> other{{1, "x"}, {7, "7"}};
+
+            map.merge(other);
+
+            REQUIRE(map.size() == 4);
+            REQUIRE(map.at(1) == "1");
+            REQUIRE(other == hash_map<int, string>{{1, "x"}});
+        }
+
+        AND_THEN("copies and moves compare equal")
+        {
+            auto copy = map;
+            REQUIRE(copy == map);
+
+            const auto moved = ::std::move(copy);
+            REQUIRE(moved == map);
+            REQUIRE(copy.empty()); // NOLINT(*-use-after-move)
+        }
+    }
+}
+
+SCENARIO("hash set growth and erasure", "[containers][hash table]") // NOLINT
+{
+    GIVEN("a hash set filled through several rehashes")
+    {
+        constexpr auto count = 10'000;
+        hash_set<int> set;
+
+        for(auto i = 0; i < count; ++i) set.insert(i);
+
+        THEN("every value is found and the load factor is bounded")
+        {
+            REQUIRE(set.size() == count);
+            REQUIRE(::std::ranges::all_of(
+                views::iota(0, count),
+                [&](const int i) { return set.contains(i); } //
+            ));
+            REQUIRE(!set.contains(count));
+            REQUIRE(set.load_factor() <= set.max_load_factor());
+        }
+
+        AND_THEN("erase_if and reinsertion reuse the slots")
+        {
+            REQUIRE(erase_if(set, [](const int i) { return i % 2 == 0; }) == count / 2);
+            REQUIRE(set.size() == count / 2);
+
+            const auto buckets = set.bucket_count();
+
+            for(auto i = 0; i < count; i += 2) set.insert(i);
+
+            REQUIRE(set.size() == count);
+            REQUIRE(set.bucket_count() == buckets);
+            REQUIRE(::std::ranges::distance(set) == count);
+        }
+
+        AND_THEN("every bucket holds at most one element")
+        {
+            size_t total = 0;
+
+            for(size_t n = 0; n < set.bucket_count(); ++n)
+            {
+                REQUIRE(set.bucket_size(n) <= 1);
+                total += static_cast<size_t>(::std::ranges::distance(set.begin(n), set.end(n)));
+            }
+
+            REQUIRE(total == set.size());
+            REQUIRE(*set.begin(set.bucket(42)) == 42);
+        }
+    }
+
+    GIVEN("a hash set with transparent hash")
+    {
+        transparent_set set{"a", "b", "c"};
+
+        THEN("string views are looked up without conversion")
+        {
+            REQUIRE(set.contains("a"sv));
+            REQUIRE(set.find("d"sv) == set.end());
+            REQUIRE(set.erase("b"sv) == 1);
+            REQUIRE(set == transparent_set{"a", "c"});
+        }
+    }
+
+    GIVEN("a hash map with transparent hash")
+    {
+        hash_map<string, int, string_hash, equal_to<>> map{{"a", 1}, {"b", 2}};
+
+        THEN("a mutable iterator extracts by position rather than as a key")
+        {
+            const auto key = map.begin()->first;
+            auto node = map.extract(map.begin());
+
+            REQUIRE(node.value().first == key);
+            REQUIRE(map.size() == 1);
+            REQUIRE(map.extract("c"sv).empty());
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: hash table operations",
+    "[.benchmark][containers][hash table]",
+    (unordered_map<uint64_t, uint64_t>),
+    (hash_map<uint64_t, uint64_t>) //
+)
+{
+    constexpr auto count = 100'000;
+
+    vector<uint64_t> keys(count * 2);
+    ::std::ranges::generate(keys, mt19937_64{});
+
+    const auto hits = ::std::span{keys}.first(count);
+    const auto misses = ::std::span{keys}.last(count);
+
+    TestType filled;
+    for(const auto k : hits) filled.emplace(k, k);
+
+    BENCHMARK("insert")
+    {
+        TestType map;
+        for(const auto k : hits) map.emplace(k, k);
+        return map.size();
+    };
+
+    BENCHMARK("lookup hit")
+    {
+        uint64_t sum = 0;
+        for(const auto k : hits) sum += filled.find(k)->second;
+        return sum;
+    };
+
+    BENCHMARK("lookup miss")
+    {
+        size_t found = 0;
+        for(const auto k : misses) found += filled.count(k);
+        return found;
+    };
+
+    BENCHMARK_ADVANCED("erase and reinsert")(Catch::Benchmark::Chronometer meter)
+    {
+        auto map = filled;
+
+        meter.measure(
+            [&]
+            {
+                for(const auto k : hits.first(count / 2)) map.erase(k);
+                for(const auto k : hits.first(count / 2)) map.emplace(k, k);
+                return map.size();
+            }
+        );
+    };
+}
\ No newline at end of file
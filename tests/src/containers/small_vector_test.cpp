@@ -0,0 +1,138 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/containers/actions.h"
+#include "stdsharp/containers/small_vector.h"
+#include "stdsharp/memory/pool_resource.h"
+#include "test.h"
+
+using namespace containers;
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: small vector concept",
+    "[containers][small vector]",
+    int,
+    unique_ptr<int>,
+    string //
+)
+{
+    using vec = small_vector<TestType, 4>;
+
+    STATIC_REQUIRE(sequence_container<vec>);
+    STATIC_REQUIRE(contiguous_container<vec>);
+    STATIC_REQUIRE(reversible_container<vec>);
+    STATIC_REQUIRE(allocator_aware_container<vec>);
+    STATIC_REQUIRE(allocator_aware_container<small_vector<TestType, 4, pool_allocator<TestType>>>);
+}
+
+SCENARIO("small vector", "[containers][small vector]") // NOLINT
+{
+    GIVEN("a small vector with inline capacity 4")
+    {
+        small_vector<string, 4> v{"1", "2", "3"};
+        const auto* const inline_data = v.data();
+
+        THEN("elements stay inline until capacity is exceeded")
+        {
+            actions::emplace_back(v, "4");
+            REQUIRE(v.data() == inline_data);
+
+            actions::emplace_back(v, "5");
+            REQUIRE(v.data() != inline_data);
+            REQUIRE(v == small_vector<string, 4>{"1", "2", "3", "4", "5"});
+
+            v.shrink_to_fit();
+            REQUIRE(v.capacity() == 5);
+
+            v.erase(v.begin() + 1, v.end());
+            v.shrink_to_fit();
+            REQUIRE(v.data() == inline_data);
+            REQUIRE(v == small_vector<string, 4>{"1"});
+        }
+
+        AND_THEN("insert and erase keep the order")
+        {
+            v.insert(v.begin() + 1, {"a", "b"});
+            v.insert(v.begin(), 2, "c");
+            v.emplace(v.end(), "d");
+
+            REQUIRE(v == small_vector<string, 4>{"c", "c", "1", "a", "b", "2", "3", "d"});
+
+            REQUIRE(actions::erase(v, "c") == 2);
+            actions::erase(v, v.cbegin());
+            REQUIRE(v == small_vector<string, 4>{"a", "b", "2", "3", "d"});
+
+            v.resize(2);
+            v.resize(3, "e");
+            REQUIRE(v == small_vector<string, 4>{"a", "b", "e"});
+            REQUIRE(v.at(2) == "e");
+            REQUIRE_THROWS_AS(v.at(3), out_of_range);
+        }
+
+        AND_THEN("growth may refer to its own element")
+        {
+            v.push_back("4");
+            v.push_back(v.front());
+            REQUIRE(v.back() == "1");
+        }
+
+        AND_THEN("copy, move and swap preserve elements")
+        {
+            auto copied = v;
+            small_vector<string, 4> heap{"a", "b", "c", "d", "e"};
+            auto moved = ::std::move(heap);
+
+            REQUIRE(copied == v);
+            REQUIRE(heap.empty());
+            REQUIRE(moved.size() == 5);
+
+            moved.swap(copied);
+            REQUIRE(moved == v);
+            REQUIRE(copied.size() == 5);
+
+            swap(copied, v);
+            REQUIRE(v.size() == 5);
+            REQUIRE(copied.size() == 3);
+            REQUIRE(copied < v);
+        }
+    }
+
+    GIVEN("a small vector using a pool allocator")
+    {
+        pool_resource<> resource;
+        pool_resource<> other_resource;
+        small_vector<int, 2, pool_allocator<int>> v{{1, 2, 3}, pool_allocator<int>{resource}};
+
+        THEN("heap capacity takes the allocator slack")
+        {
+            REQUIRE(v.capacity() == 4);
+        }
+
+        AND_THEN("move assignment propagates the allocator")
+        {
+            small_vector<int, 2, pool_allocator<int>> other{pool_allocator<int>{other_resource}};
+
+            other = v;
+            REQUIRE(other.get_allocator() == pool_allocator<int>{other_resource});
+
+            other = ::std::move(v);
+            REQUIRE(other.get_allocator() == pool_allocator<int>{resource});
+            REQUIRE(::std::ranges::equal(other, array{1, 2, 3}));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: small vector append",
+    "[.benchmark][containers][small vector]",
+    (vector<int>),
+    (small_vector<int, 8>) //
+)
+{
+    for(const auto count : {4, 8, 64})
+        BENCHMARK(fmt::format("append {}", count))
+        {
+            TestType v;
+            for(auto i = 0; i < count; ++i) v.push_back(i);
+            return v.size();
+        };
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <random>
+
+#include "stdsharp/cuchar/utf.h"
+#include "stdsharp/cuchar/utf8.h"
+#include "test.h"
+
+namespace
+{
+    // byte at a time reference, the offset of the first invalid character
+    size_t reference_prefix(const ::std::string_view str)
+    {
+        size_t i = 0;
+
+        while(i < str.size())
+        {
+            const auto length = details::decode_utf(str.data() + i, str.size() - i).length;
+
+            if(length == 0) break;
+
+            i += length;
+        }
+
+        return i;
+    }
+
+    // valid text of every character length with random bytes mutated
+    ::std::string mutated_text(mt19937& gen, const size_t size, const size_t mutations)
+    {
+        uniform_int_distribution<unsigned> kind{0, 3};
+        uniform_int_distribution<unsigned> byte{0, 255};
+        u32string utf32;
+
+        while(utf32.size() < size)
+        {
+            const auto [min, max] = ::std::array<pair<char32_t, char32_t>, 4>{
+                pair{U'\x01', U'\x7F'},
+                pair{U'\x80', U'\x7FF'},
+                pair{U'\xE000', U'\xFFFF'},
+                pair{U'\x10000', U'\x10FFFF'} //
+            }[kind(gen)];
+
+            utf32 += uniform_int_distribution<char32_t>{min, max}(gen);
+        }
+
+        auto text = transcode<char>(utf32);
+
+        for(auto n = mutations; n != 0; --n)
+            text[uniform_int_distribution<size_t>{0, text.size() - 1}(gen)] =
+                static_cast<char>(byte(gen));
+
+        return text;
+    }
+}
+
+SCENARIO("validate UTF-8", "[cuchar]") // NOLINT
+{
+    GIVEN("valid and mutated text")
+    {
+        mt19937 gen{GENERATE(1U, 2U, 3U, 4U)};
+
+        THEN("the valid prefix matches the scalar decoder")
+        {
+            for(size_t n = 0; n < 500; ++n)
+            {
+                const auto text = mutated_text(gen, n % 150, n % 3);
+                const auto expected = reference_prefix(text);
+
+                REQUIRE(valid_utf8_prefix(text) == expected);
+                REQUIRE(is_valid_utf8(text) == (expected == text.size()));
+            }
+        }
+    }
+
+    GIVEN("random bytes")
+    {
+        mt19937 gen{GENERATE(5U, 6U)};
+        uniform_int_distribution<unsigned> byte{0, 255};
+
+        THEN("the valid prefix matches the scalar decoder")
+        {
+            for(size_t n = 0; n < 500; ++n)
+            {
+                ::std::string text(n % 100, '\0');
+
+                // mostly continuations and leads so that the error is rarely at the start
+                for(auto& c : text) c = static_cast<char>(byte(gen) | (n % 2 == 0 ? 0x80 : 0));
+
+                REQUIRE(valid_utf8_prefix(text) == reference_prefix(text));
+            }
+        }
+    }
+
+    GIVEN("every error class at every offset across block boundaries")
+    {
+        const auto sequence = GENERATE(
+            ::std::string_view{"\xC0\x80"}, // overlong 2
+            ::std::string_view{"\xE0\x9F\xBF"}, // overlong 3
+            ::std::string_view{"\xF0\x8F\xBF\xBF"}, // overlong 4
+            ::std::string_view{"\xED\xA0\x80"}, // surrogate
+            ::std::string_view{"\xF4\x90\x80\x80"}, // too large
+            ::std::string_view{"\xF5\x80\x80\x80"}, // too large lead
+            ::std::string_view{"\xE4\xB8"}, // too short
+            ::std::string_view{"\xE4\xB8z"}, // too short
+            ::std::string_view{"\x80"}, // too long
+            ::std::string_view{"\xFF"}
+        );
+
+        THEN("the offset of the invalid character is reported")
+        {
+            for(size_t offset = 0; offset < 70; ++offset)
+            {
+                ::std::string text(offset, 'a');
+
+                // multi byte characters so that the error is not always after ASCII
+                for(size_t i = 0; i + 2 <= offset; i += 5) text.replace(i, 2, "\xC3\xA9");
+
+                text += sequence;
+                text.append(offset % 40, 'b');
+
+                INFO(offset);
+                REQUIRE(valid_utf8_prefix(text) == offset);
+                REQUIRE(valid_utf8_prefix(::std::u8string_view{
+                            reinterpret_cast<const char8_t*>(text.data()), // NOLINT
+                            text.size() //
+                        }) == offset);
+            }
+        }
+    }
+
+    GIVEN("characters of every length")
+    {
+        const ::std::string text = "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80\n";
+
+        THEN("code points and lines are counted")
+        {
+            ::std::string repeated;
+
+            for(auto n = 0; n < 1000; ++n) repeated += text;
+
+            const auto [code_points, lines] = count_utf8(repeated);
+
+            REQUIRE(code_points == 5000);
+            REQUIRE(lines == 1000);
+            REQUIRE(is_valid_utf8(repeated));
+            REQUIRE(count_utf8(::std::string_view{}).code_points == 0);
+        }
+    }
+}
+
+SCENARIO("validate UTF-8 throughput", "[.benchmark][cuchar]") // NOLINT
+{
+    mt19937 gen{1};
+    const auto mixed = mutated_text(gen, 1 << 20, 0);
+    ::std::string ascii(mixed.size(), 'a');
+
+    for(size_t i = 0; i < ascii.size(); i += 80) ascii[i] = '\n';
+
+    BENCHMARK("mixed is_valid_utf8") { return is_valid_utf8(mixed); };
+
+    BENCHMARK("ASCII is_valid_utf8") { return is_valid_utf8(ascii); };
+
+    BENCHMARK("mixed scalar decode") { return reference_prefix(mixed); };
+
+    BENCHMARK("mixed count_utf8") { return count_utf8(mixed).code_points; };
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <clocale>
+#include <random>
+
+#include "stdsharp/cuchar/cuchar.h"
+#include "stdsharp/cuchar/utf.h"
+#include "test.h"
+
+namespace
+{
+    // runs of ASCII, two and three byte characters and supplementary ones, long enough for the
+    // block kernels and mixed enough for the scalar path
+    u32string random_text(const size_t size, const unsigned seed)
+    {
+        mt19937 gen{seed};
+        uniform_int_distribution<unsigned> kind{0, 3};
+        uniform_int_distribution<size_t> run{1, 40};
+        u32string text;
+
+        while(text.size() < size)
+        {
+            const auto [min, max] = ::std::array<pair<char32_t, char32_t>, 4>{
+                pair{U'\x01', U'\x7F'},
+                pair{U'\x80', U'\x7FF'},
+                pair{U'\xE000', U'\xFFFF'},
+                pair{U'\x10000', U'\x10FFFF'} //
+            }[kind(gen)];
+            uniform_int_distribution<char32_t> cp{min, max};
+
+            for(auto n = run(gen); n != 0; --n) text += cp(gen);
+        }
+
+        return text;
+    }
+}
+
+SCENARIO("transcode UTF", "[cuchar]") // NOLINT
+{
+    GIVEN("valid text with characters of every length")
+    {
+        const auto seed = GENERATE(1U, 2U, 3U, 4U);
+        const auto utf32 = random_text(1000, seed);
+
+        THEN("transcoding round trips between every encoding")
+        {
+            const auto utf8 = transcode<char8_t>(utf32);
+            const auto utf16 = transcode<char16_t>(utf32);
+
+            REQUIRE(transcode<char32_t>(utf8) == utf32);
+            REQUIRE(transcode<char32_t>(utf16) == utf32);
+            REQUIRE(transcode<char16_t>(utf8) == utf16);
+            REQUIRE(transcode<char8_t>(utf16) == utf8);
+            REQUIRE(transcode<char8_t>(utf8) == utf8);
+            REQUIRE(transcode<wchar_t>(utf8).size() >= utf32.size());
+        }
+    }
+
+    GIVEN("ASCII and BMP text")
+    {
+        const ::std::u16string utf16 = u"plain ASCII text long enough for blocks, "
+                                       u"中文文本中文文本"
+                                       u"中文文本中文文本";
+
+        THEN("the output matches the scalar encoding")
+        {
+            REQUIRE(
+                transcode<char>(utf16) ==
+                "plain ASCII text long enough for blocks, "
+                "中文文本中文文本"
+                "中文文本中文文本"
+            );
+            REQUIRE(transcode<char16_t>(transcode<char32_t>(utf16)) == utf16);
+        }
+    }
+
+    GIVEN("invalid input")
+    {
+        const auto invalid_at = []<typename CharT>(const ::std::basic_string_view<CharT> in)
+        {
+            ::std::array<char32_t, 64> out{};
+            const auto result = transcode<char32_t>(in, ::std::span{out});
+
+            REQUIRE(result.ec == errc::illegal_byte_sequence);
+            return result.read;
+        };
+
+        THEN("the offset of the first invalid character is reported")
+        {
+            const ::std::string padding(20, 'a');
+
+            REQUIRE(invalid_at(::std::string_view{padding + "\xC0\x80"}) == 20); // overlong
+            REQUIRE(invalid_at(::std::string_view{padding + "\xED\xA0\x80"}) == 20); // surrogate
+            REQUIRE(invalid_at(::std::string_view{padding + "\xF4\x90\x80\x80"}) == 20);
+            REQUIRE(invalid_at(::std::string_view{padding + "\xE4\xB8"}) == 20); // truncated
+            REQUIRE(invalid_at(::std::string_view{padding + "\x80"}) == 20);
+            REQUIRE(invalid_at(::std::u16string_view{u"ab\xDC00"}) == 2);
+            REQUIRE(invalid_at(::std::u16string_view{u"ab\xD800z"}) == 2);
+            REQUIRE(invalid_at(::std::u32string_view{U"abc\x110000"}) == 3);
+        }
+
+        AND_THEN("the converting overload throws")
+        {
+            REQUIRE_THROWS_AS(
+                transcode<char16_t>(::std::string_view{"\xFF"}),
+                ::std::runtime_error
+            );
+        }
+    }
+
+    GIVEN("an output too small")
+    {
+        ::std::array<char8_t, 5> out{};
+
+        THEN("the complete characters that fit are written")
+        {
+            const auto result = transcode<char8_t>(::std::u32string_view{U"ab中中"}, out);
+
+            REQUIRE(result.ec == errc::value_too_large);
+            REQUIRE(result.read == 3);
+            REQUIRE(result.written == 5);
+        }
+    }
+}
+
+SCENARIO("transcode UTF throughput", "[.benchmark][cuchar]") // NOLINT
+{
+    const auto utf32 = random_text(1 << 20, 1);
+    const auto utf16 = transcode<char16_t>(utf32);
+    const auto utf8 = transcode<char8_t>(utf32);
+
+    ::std::u32string bmp(1 << 20, U'中');
+    ::std::u16string ascii(1 << 20, u'a');
+
+    for(auto i = 0; i < 1 << 20; i += 64) ascii[static_cast<size_t>(i)] = u'é';
+
+    BENCHMARK("mixed UTF-16 to UTF-8") { return transcode<char8_t>(utf16).size(); };
+
+    BENCHMARK("mixed UTF-8 to UTF-16") { return transcode<char16_t>(utf8).size(); };
+
+    BENCHMARK("mostly ASCII UTF-16 to UTF-8") { return transcode<char8_t>(ascii).size(); };
+
+    BENCHMARK("BMP UTF-32 to UTF-16") { return transcode<char16_t>(bmp).size(); };
+
+    ::std::setlocale(LC_ALL, "C.UTF-8"); // NOLINT(*-mt-unsafe)
+
+    BENCHMARK("mostly ASCII UTF-16 per character encode_to_string_fn")
+    {
+        ::std::string str;
+        for(const auto c : ascii) str += encode_to_string_fn<char16_t>{}(c);
+        return str.size();
+    };
+
+    ::std::setlocale(LC_ALL, "C"); // NOLINT(*-mt-unsafe)
+}
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <fstream>
+
+#include "stdsharp/filesystem/directory_usage.h"
+#include "stdsharp/filesystem/directory_usage_cache.h"
+#include "test.h"
+
+using namespace stdsharp::filesystem;
+
+namespace
+{
+    // directory tree in the temp directory removed on destruction, every directory holds
+    // `width` files of `file_size` bytes and `width` subdirectories down to `depth`
+    class temp_tree
+    {
+        ::std::filesystem::path root_;
+
+        static void fill(
+            const ::std::filesystem::path& dir,
+            const size_t width,
+            const size_t depth,
+            const size_t file_size //
+        )
+        {
+            ::std::filesystem::create_directory(dir);
+
+            for(size_t i = 0; i < width; ++i)
+            {
+                ::std::ofstream{dir / ::fmt::format("file_{}", i)} << string(file_size, 'x');
+                if(depth > 0) fill(dir / ::fmt::format("dir_{}", i), width, depth - 1, file_size);
+            }
+        }
+
+    public:
+        temp_tree(
+            const ::std::string_view name,
+            const size_t width,
+            const size_t depth,
+            const size_t file_size //
+        ):
+            root_(::std::filesystem::temp_directory_path() / name)
+        {
+            ::std::filesystem::remove_all(root_);
+            fill(root_, width, depth, file_size);
+        }
+
+        temp_tree(const temp_tree&) = delete;
+        temp_tree(temp_tree&&) = delete;
+        temp_tree& operator=(const temp_tree&) = delete;
+        temp_tree& operator=(temp_tree&&) = delete;
+
+        ~temp_tree() { ::std::filesystem::remove_all(root_); }
+
+        [[nodiscard]] const auto& path() const noexcept { return root_; }
+
+        // moves the modification time of every directory an hour back, so that the cache
+        // doesn't treat them as racily modified
+        void age() const
+        {
+            const auto time = ::std::filesystem::file_time_type::clock::now() - 1h;
+
+            ::std::filesystem::last_write_time(root_, time);
+
+            for(const auto& entry : ::std::filesystem::recursive_directory_iterator{root_})
+                if(entry.is_directory()) ::std::filesystem::last_write_time(entry.path(), time);
+        }
+    };
+}
+
+SCENARIO("directory usage", "[filesystem]") // NOLINT
+{
+    using bytes = stdsharp::filesystem::bytes;
+
+    GIVEN("a directory tree of 3 levels with 3 files and 3 subdirectories each")
+    {
+        const temp_tree tree{"stdsharp_directory_usage", 3, 2, 100};
+
+        // 1 + 3 + 9 directories with 3 files each
+        constexpr uintmax_t directories = 13;
+        constexpr uintmax_t files = directories * 3;
+
+        const auto thread_count = GENERATE(size_t{1}, size_t{4});
+        const auto result = directory_usage(tree.path(), {.thread_count = thread_count});
+
+        THEN("every entry is counted")
+        {
+            REQUIRE(result.total.directories == directories);
+            REQUIRE(result.total.files == files);
+            REQUIRE(result.total.apparent_size >= bytes{files * 100});
+            REQUIRE(result.skipped == 0);
+            REQUIRE(result.subtrees.empty());
+        }
+
+        AND_THEN("depth limit stops entering deeper directories")
+        {
+            const auto limited =
+                directory_usage(tree.path(), {.thread_count = thread_count, .max_depth = 1});
+
+            // the deepest directories are counted but not entered
+            REQUIRE(limited.total.directories == directories);
+            REQUIRE(limited.total.files == 3 + 3 * 3);
+        }
+
+        AND_THEN("breakdown totals add up to the total")
+        {
+            const auto broken_down = directory_usage(
+                tree.path(),
+                {.thread_count = thread_count, .breakdown_depth = 2} //
+            );
+
+            REQUIRE(broken_down.total == result.total);
+            REQUIRE(broken_down.subtrees.size() == 12);
+            REQUIRE(::std::ranges::is_sorted(
+                broken_down.subtrees,
+                {},
+                &directory_usage_result::subtree_usage::first //
+            ));
+
+            space_usage first_level;
+
+            for(const auto& [path, usage] : broken_down.subtrees)
+                if(path.parent_path() == tree.path())
+                {
+                    REQUIRE(usage.directories == 4);
+                    REQUIRE(usage.files == 12);
+                    first_level += usage;
+                }
+
+            REQUIRE(first_level.directories + 1 == result.total.directories);
+            REQUIRE(first_level.files + 3 == result.total.files);
+        }
+    }
+
+    GIVEN("a missing directory")
+    {
+        THEN("directory usage throws filesystem error")
+        {
+            REQUIRE_THROWS_AS(
+                directory_usage(::std::filesystem::temp_directory_path() / "stdsharp_missing"),
+                ::std::filesystem::filesystem_error
+            );
+        }
+    }
+}
+
+SCENARIO("directory usage cache", "[filesystem]") // NOLINT
+{
+    GIVEN("a cache of a directory tree")
+    {
+        const temp_tree tree{"stdsharp_directory_usage_cache", 3, 2, 100};
+        const auto index = ::std::filesystem::temp_directory_path() / "stdsharp_usage_index";
+        directory_usage_cache cache{tree.path()};
+
+        tree.age();
+
+        REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+        REQUIRE(cache.rescanned_directories() == 13);
+
+        THEN("unchanged directories aren't read again")
+        {
+            REQUIRE(cache.refresh() == cache.total());
+            REQUIRE(cache.rescanned_directories() == 0);
+        }
+
+        AND_THEN("only changed directories are read again")
+        {
+            ::std::ofstream{tree.path() / "dir_0" / "new_file"} << "new";
+            ::std::filesystem::remove_all(tree.path() / "dir_1");
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+            REQUIRE(cache.rescanned_directories() == 2);
+            REQUIRE(cache.total().directories == 9);
+        }
+
+        AND_THEN("saved index is loaded by another cache of the same root")
+        {
+            cache.save(index);
+
+            directory_usage_cache loaded{tree.path(), index};
+            directory_usage_cache other{tree.path() / "dir_0", index};
+
+            ::std::filesystem::remove(index);
+
+            REQUIRE(loaded.refresh() == cache.total());
+            REQUIRE(loaded.rescanned_directories() == 0);
+
+            REQUIRE(other.refresh() == directory_usage(tree.path() / "dir_0").total);
+            REQUIRE(other.rescanned_directories() == 4);
+        }
+
+        AND_THEN("watched directories catch files changed in place")
+        {
+            if(!cache.watch()) return; // inotify isn't available
+
+            REQUIRE(cache.refresh() == cache.total());
+
+            ::std::ofstream{tree.path() / "dir_2" / "dir_0" / "file_0", ::std::ios::app}
+                << "appended";
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+            REQUIRE(cache.rescanned_directories() == 1);
+
+            ::std::filesystem::create_directories(tree.path() / "dir_2" / "new" / "nested");
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+            REQUIRE(cache.total().directories == 15);
+
+            REQUIRE(cache.refresh() == cache.total());
+            REQUIRE(cache.rescanned_directories() == 0);
+        }
+
+        AND_THEN("watched directories moved up the tree keep their watches")
+        {
+            if(!cache.watch()) return; // inotify isn't available
+
+            REQUIRE(cache.refresh() == cache.total());
+
+            const auto moved = tree.path() / "moved";
+
+            ::std::filesystem::rename(tree.path() / "dir_2" / "dir_1", moved);
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+
+            ::std::ofstream{moved / "file_0", ::std::ios::app} << "appended";
+            ::std::ofstream{moved / "dir_0" / "file_0", ::std::ios::app} << "appended";
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+        }
+
+        AND_THEN("files changed in place after lost events are caught")
+        {
+            size_t max_queued_events = 0;
+
+            if(!cache.watch()) return; // inotify isn't available
+            if(!(::std::ifstream{"/proc/sys/fs/inotify/max_queued_events"} >> max_queued_events))
+                return;
+
+            REQUIRE(cache.refresh() == cache.total());
+
+            // created and removed files overflow the event queue
+            for(size_t i = 0; i < max_queued_events; ++i)
+            {
+                const auto file = tree.path() / ::fmt::format("flood_{}", i);
+
+                ::std::ofstream{file}.close();
+                ::std::filesystem::remove(file);
+            }
+
+            ::std::ofstream{tree.path() / "dir_2" / "dir_0" / "file_0", ::std::ios::app}
+                << "appended";
+
+            REQUIRE(cache.refresh() == directory_usage(tree.path()).total);
+        }
+    }
+
+    GIVEN("a cache of a missing directory")
+    {
+        directory_usage_cache cache{
+            ::std::filesystem::temp_directory_path() / "stdsharp_missing" //
+        };
+
+        THEN("refresh throws filesystem error")
+        {
+            REQUIRE_THROWS_AS(cache.refresh(), ::std::filesystem::filesystem_error);
+        }
+    }
+}
+
+SCENARIO("directory usage of a large tree", "[.benchmark][filesystem]") // NOLINT
+{
+    // 1 + 8 + 64 + 512 + 4096 directories with 8 files each
+    const temp_tree tree{"stdsharp_directory_usage_bench", 8, 4, 10};
+
+    BENCHMARK("recursive_directory_iterator")
+    {
+        uintmax_t size = 0;
+
+        for(const auto& entry : ::std::filesystem::recursive_directory_iterator{tree.path()})
+            if(entry.is_regular_file()) size += entry.file_size();
+
+        return size;
+    };
+
+    for(const size_t thread_count : {1, 4})
+        BENCHMARK(::fmt::format("directory_usage {} threads", thread_count))
+        {
+            return directory_usage(tree.path(), {.thread_count = thread_count}).total;
+        };
+
+    tree.age();
+
+    directory_usage_cache polled{tree.path()};
+    directory_usage_cache watched{tree.path()};
+
+    watched.watch();
+    polled.refresh();
+    watched.refresh();
+
+    BENCHMARK("directory_usage_cache unchanged refresh") { return polled.refresh(); };
+
+    BENCHMARK("directory_usage_cache watched unchanged refresh") { return watched.refresh(); };
+}
\ No newline at end of file
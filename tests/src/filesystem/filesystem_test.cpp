@@ -1,3 +1,5 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
 #include "stdsharp/filesystem/filesystem.h"
 #include "test.h"
 
@@ -40,5 +42,46 @@ SCENARIO("space size", "[filesystem]") // NOLINT
         REQUIRE(FORMAT_NS::format("{:-^5.1GB}", v) == "-1GB-");
         REQUIRE(FORMAT_NS::format("{:.4GB}", v) == "1GB0MB42KB0B");
         REQUIRE(FORMAT_NS::format("{}", 1.2_GB) == "1.2GB");
+        REQUIRE(FORMAT_NS::format("{:L}", v) == FORMAT_NS::format("{}", v));
+        REQUIRE(FORMAT_NS::format("{:L}", 1.2_GB) == "1.2GB");
     }
-};
\ No newline at end of file
+
+    {
+        REQUIRE(FORMAT_NS::format("{:h}", 1023_B) == "1023B");
+        REQUIRE(FORMAT_NS::format("{:h}", 1536_B) == "1.5KiB");
+        REQUIRE(FORMAT_NS::format("{:h}", 1'048'575_B) == "1.0MiB");
+        REQUIRE(FORMAT_NS::format("{:.2H}", 1'234'567_B) == "1.23MB");
+        REQUIRE(FORMAT_NS::format("{:.0h}", 3_GiB) == "3GiB");
+        REQUIRE(FORMAT_NS::format("{:*>8h}", 2_GiB) == "**2.0GiB");
+        REQUIRE(FORMAT_NS::format("{:Lh}", 1.5_KiB) == "1.5KiB");
+
+        // fractional bytes rounding up to the next unit
+        REQUIRE(FORMAT_NS::format("{:h}", 1023.4_B) == "1023B");
+        REQUIRE(FORMAT_NS::format("{:h}", 1023.99_B) == "1.0KiB");
+        REQUIRE(FORMAT_NS::format("{:.2Lh}", 1023.99_B) == "1.00KiB");
+        REQUIRE(FORMAT_NS::format("{:H}", 999.5_B) == "1.0KB");
+    }
+};
+
+SCENARIO("format space size", "[.benchmark][filesystem]") // NOLINT
+{
+    const auto sizes = []
+    {
+        vector<stdsharp::filesystem::bytes> sizes;
+
+        for(uintmax_t i = 0; i < 1000; ++i) sizes.emplace_back(i * i * i * 7919);
+
+        return sizes;
+    }();
+
+    for(const auto spec : {"{}", "{:L}", "{:.2GiB}", "{:.2LGiB}", "{:h}", "{:Lh}"})
+        BENCHMARK(::fmt::format("format {}", spec))
+        {
+            size_t size = 0;
+
+            for(const auto& s : sizes)
+                size += FORMAT_NS::vformat(spec, FORMAT_NS::make_format_args(s)).size();
+
+            return size;
+        };
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/filesystem/filesystem.h"
+#include "test.h"
+
+using namespace stdsharp::filesystem;
+using stdsharp::fmt::with_spec;
+
+#if __cpp_lib_format >= 201907L
+    #define FORMAT_NS ::std
+#else
+    #define FORMAT_NS ::fmt
+#endif
+
+SCENARIO("format with compile time parsed spec", "[format]") // NOLINT
+{
+    GIVEN("a space size")
+    {
+        constexpr auto v = 1'000'042_KB;
+
+        THEN("the output is the same as with the spec in the format string")
+        {
+            REQUIRE(FORMAT_NS::format("{}", with_spec<"-<5MB">(v)) == "1000MB42KB");
+            REQUIRE(FORMAT_NS::format("{}", with_spec<"-^5.1GB">(v)) == "-1GB-");
+            REQUIRE(FORMAT_NS::format("{}", with_spec<"h">(1536_B)) == "1.5KiB");
+            REQUIRE(
+                FORMAT_NS::format("{}", with_spec<"*>12.2GB">(v)) ==
+                FORMAT_NS::format("{:*>12.2GB}", v) //
+            );
+        }
+    }
+
+    GIVEN("a space size with nested width and precision")
+    {
+        constexpr auto v = 1'000'042_KB;
+
+        THEN("the arguments are resolved by automatic or explicit index")
+        {
+            REQUIRE(FORMAT_NS::format("{:*>{}.{}GB}", v, 12, 2) == "******1GB0MB");
+            REQUIRE(FORMAT_NS::format("{0:*>{2}.{1}GB}", v, 2, 12) == "******1GB0MB");
+        }
+
+        AND_THEN("negative width is ignored")
+        {
+            REQUIRE(FORMAT_NS::format("{:*>{}.{}GB}", v, -12, 2) == "1GB0MB");
+        }
+    }
+
+    GIVEN("an integer")
+    {
+        THEN("formatters of the library are parsed at compile time as well")
+        {
+            REQUIRE(FORMAT_NS::format("{}", with_spec<"*^7x">(255)) == "**ff***");
+        }
+    }
+}
+
+SCENARIO("format space size with compile time parsed spec", "[.benchmark][format]") // NOLINT
+{
+    constexpr auto v = 1'000'042_KB;
+
+    BENCHMARK("spec in the format string") { return FORMAT_NS::format("{:-^20.2GB}", v); };
+
+    BENCHMARK("with_spec") { return FORMAT_NS::format("{}", with_spec<"-^20.2GB">(v)); };
+}
+
+SCENARIO("format space size with nested spec", "[.benchmark][format]") // NOLINT
+{
+    constexpr auto v = 1'000'042_KB;
+
+    BENCHMARK("static width and precision") { return FORMAT_NS::format("{:*>20.2GB}", v); };
+
+    BENCHMARK("nested width and precision")
+    {
+        return FORMAT_NS::format("{:*>{}.{}GB}", v, 20, 2);
+    };
+
+    BENCHMARK("nested width and precision by index")
+    {
+        return FORMAT_NS::format("{0:*>{1}.{2}GB}", v, 20, 2);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,480 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/fstream/async_file_reader.h"
+#include "stdsharp/fstream/fstream.h"
+#include "test.h"
+
+namespace
+{
+    // file in the temp directory removed on destruction
+    class temp_file
+    {
+        filesystem::path path_;
+
+    public:
+        explicit temp_file(const ::std::string_view name, const ::std::string_view content):
+            path_(filesystem::temp_directory_path() / name)
+        {
+            ofstream{path_, ios::binary}.write(
+                content.data(),
+                static_cast<streamsize>(content.size())
+            );
+        }
+
+        temp_file(const temp_file&) = delete;
+        temp_file(temp_file&&) = delete;
+        temp_file& operator=(const temp_file&) = delete;
+        temp_file& operator=(temp_file&&) = delete;
+
+        ~temp_file() { filesystem::remove(path_); }
+
+        [[nodiscard]] const auto& path() const noexcept { return path_; }
+    };
+
+    struct detached_task
+    {
+        struct promise_type
+        {
+            static constexpr detached_task get_return_object() noexcept { return {}; }
+
+            static constexpr suspend_never initial_suspend() noexcept { return {}; }
+
+            static constexpr suspend_never final_suspend() noexcept { return {}; }
+
+            static constexpr void return_void() noexcept {}
+
+            [[noreturn]] static void unhandled_exception() noexcept { terminate(); }
+        };
+    };
+
+    template<typename... Executor>
+    detached_task read_to(
+        async_file_reader& reader,
+        const filesystem::path& path,
+        promise<string>& result,
+        Executor... executor //
+    )
+    {
+        try
+        {
+            result.set_value(co_await reader.async_read_text(path, executor...));
+        }
+        catch(...)
+        {
+            result.set_exception(current_exception());
+        }
+    }
+
+    // submits a batch from the thread the read resumed on
+    detached_task read_then_batch(
+        async_file_reader& reader,
+        const filesystem::path& path,
+        const vector<filesystem::path>& paths,
+        promise<vector<future<string>>>& result //
+    )
+    {
+        static_cast<void>(co_await reader.async_read_text(path));
+        result.set_value(reader.read_texts(paths));
+    }
+}
+
+SCENARIO("read all text", "[fstream]") // NOLINT
+{
+    GIVEN("a file with text")
+    {
+        const string content = "first line\nsecond line\n\0binary"s;
+        const temp_file file{"stdsharp_read_all_text.txt", content};
+
+        THEN("read_all_text copies the whole content")
+        {
+            REQUIRE(read_all_text(file.path()) == content);
+        }
+
+        AND_THEN("read_all_mapped views the whole content")
+        {
+            const auto mapped = read_all_mapped(file.path());
+
+            REQUIRE(mapped.text() == content);
+            REQUIRE(mapped.bytes().size() == content.size());
+        }
+
+        AND_THEN("moved mapped file keeps the view")
+        {
+            auto mapped = read_all_mapped(file.path(), mapped_file::access_advice::random);
+            const auto* const data = mapped.data();
+            const auto moved = ::std::move(mapped);
+
+            REQUIRE(moved.data() == data);
+            REQUIRE(mapped.empty()); // NOLINT(*-use-after-move)
+        }
+    }
+
+    GIVEN("an empty file")
+    {
+        const temp_file file{"stdsharp_read_all_text_empty.txt", ""};
+
+        THEN("the mapped view is empty") { REQUIRE(read_all_mapped(file.path()).empty()); }
+    }
+
+    GIVEN("a missing file")
+    {
+        const auto path = filesystem::temp_directory_path() / "stdsharp_missing_file";
+
+        THEN("mapping throws filesystem error")
+        {
+            REQUIRE_THROWS_AS(mapped_file{path}, filesystem::filesystem_error);
+        }
+
+        AND_THEN("read_all_text returns empty text") { REQUIRE(read_all_text(path).empty()); }
+    }
+
+    GIVEN("a file that reports no size")
+    {
+        const filesystem::path path{"/proc/self/status"};
+
+        THEN("read_all_text reads it as a stream")
+        {
+            if(!filesystem::exists(path)) return; // no procfs
+
+            REQUIRE(filesystem::file_size(path) == 0);
+            REQUIRE(read_all_text(path).starts_with("Name:"));
+        }
+    }
+}
+
+SCENARIO("read files asynchronously", "[fstream]") // NOLINT
+{
+    GIVEN("a reader with io_uring or the thread pool fallback")
+    {
+        const auto queue_depth = GENERATE(0U, 2U, 4U, async_file_reader::default_queue_depth);
+        async_file_reader reader{queue_depth, 2};
+
+        INFO(fmt::format("queue depth {}, io_uring {}", queue_depth, reader.uses_io_uring()));
+
+        if(queue_depth == 0) REQUIRE(!reader.uses_io_uring());
+
+        THEN("files are read whole")
+        {
+            const string content(100'000, 'x');
+            const temp_file file{"stdsharp_async_read.txt", content};
+            const temp_file empty{"stdsharp_async_read_empty.txt", ""};
+
+            auto future = reader.read_text(file.path());
+
+            REQUIRE(reader.read_text(empty.path()).get().empty());
+            REQUIRE(future.get() == content);
+        }
+
+        AND_THEN("files that report no size are read until the end")
+        {
+            const filesystem::path status{"/proc/self/status"};
+
+            if(!filesystem::exists(status)) return; // no procfs
+
+            const temp_file empty{"stdsharp_async_read_empty.txt", ""};
+            auto future = reader.read_text(status);
+
+            REQUIRE(reader.read_text(empty.path()).get().empty());
+            REQUIRE(future.get().starts_with("Name:"));
+        }
+
+        AND_THEN("batches more files than the queue depth")
+        {
+            vector<unique_ptr<temp_file>> files;
+            vector<filesystem::path> paths;
+
+            for(auto i = 0; i < 50; ++i)
+            {
+                files.push_back(make_unique<temp_file>(
+                    fmt::format("stdsharp_async_read_{}.txt", i),
+                    fmt::format("file {}", i)
+                ));
+                paths.push_back(files.back()->path());
+            }
+
+            auto futures = reader.read_texts(paths);
+
+            for(auto i = 0; i < 50; ++i)
+                REQUIRE(futures[static_cast<size_t>(i)].get() == fmt::format("file {}", i));
+
+            AND_THEN("a resumed coroutine submits a batch while another batch waits")
+            {
+                promise<vector<future<string>>> result;
+
+                read_then_batch(reader, paths.front(), paths, result);
+                futures = reader.read_texts(paths);
+
+                auto resumed = result.get_future().get();
+
+                for(auto i = 0; i < 50; ++i)
+                {
+                    const auto expected = fmt::format("file {}", i);
+
+                    REQUIRE(futures[static_cast<size_t>(i)].get() == expected);
+                    REQUIRE(resumed[static_cast<size_t>(i)].get() == expected);
+                }
+            }
+        }
+
+        AND_THEN("awaiting coroutines are resumed with the content")
+        {
+            const temp_file file{"stdsharp_async_await.txt", "awaited"};
+            promise<string> result;
+
+            read_to(reader, file.path(), result);
+
+            REQUIRE(result.get_future().get() == "awaited");
+        }
+
+        AND_THEN("the executor keeps working after the resumed coroutine finishes")
+        {
+            const temp_file file{"stdsharp_async_await.txt", "awaited"};
+            promise<string> result;
+            auto resumed = make_shared<::std::atomic_int>(0);
+
+            read_to(
+                reader,
+                file.path(),
+                result,
+                [resumed](const coroutine_handle<> h)
+                {
+                    h.resume();
+                    ++*resumed;
+                    resumed->notify_one();
+                } //
+            );
+
+            REQUIRE(result.get_future().get() == "awaited");
+
+            resumed->wait(0);
+            REQUIRE(*resumed == 1);
+        }
+
+        AND_THEN("missing files throw filesystem error")
+        {
+            const auto missing = filesystem::temp_directory_path() / "stdsharp_missing_file";
+            promise<string> result;
+
+            read_to(reader, missing, result);
+
+            REQUIRE_THROWS_AS(reader.read_text(missing).get(), filesystem::filesystem_error);
+            REQUIRE_THROWS_AS(result.get_future().get(), filesystem::filesystem_error);
+        }
+    }
+}
+
+SCENARIO("read numbers in chunks", "[fstream]") // NOLINT
+{
+    GIVEN("a stream of whitespace separated numbers")
+    {
+        istringstream is{" 1 -22\n333\t4444 \r\n55555\n"};
+
+        THEN("tokens crossing the chunk boundary are parsed whole")
+        {
+            REQUIRE(
+                ::std::ranges::equal(
+                    from_chars_reader<int>{is, 4},
+                    array{1, -22, 333, 4444, 55555} //
+                )
+            );
+            REQUIRE(is.eof());
+            REQUIRE(!is.fail());
+        }
+
+        AND_THEN("read_all_to_container doesn't append a value at the end")
+        {
+            vector<long> values;
+            REQUIRE(
+                read_all_to_container<long>(values, is) ==
+                vector<long>{1, -22, 333, 4444, 55555} //
+            );
+        }
+    }
+
+    GIVEN("a stream with an invalid token")
+    {
+        istringstream is{"1.5 2.25 x 3"};
+
+        THEN("parsing stops and sets failbit")
+        {
+            REQUIRE(read_all<double>(is) == vector{1.5, 2.25});
+            REQUIRE(is.fail());
+        }
+    }
+
+    GIVEN("numbers with signs")
+    {
+        THEN("a plus sign is accepted as operator>> does")
+        {
+            istringstream signed_is{"+1\n2\n-3 +45"};
+            istringstream unsigned_is{"+7 +-8"};
+            istringstream split_is{"1 +22"};
+
+            REQUIRE(read_all<int>(signed_is) == vector{1, 2, -3, 45});
+            REQUIRE(read_all<unsigned>(unsigned_is) == vector{7U});
+            REQUIRE(unsigned_is.fail());
+            REQUIRE(::std::ranges::equal(from_chars_reader<int>{split_is, 3}, array{1, 22}));
+        }
+    }
+
+    GIVEN("a file of numbers")
+    {
+        const temp_file file{"stdsharp_read_all.txt", "1\n2\n3\n"};
+
+        THEN("read_all parses the file") { REQUIRE(read_all<int>(file.path()) == vector{1, 2, 3}); }
+    }
+}
+
+SCENARIO("read numbers in parallel", "[fstream]") // NOLINT
+{
+    GIVEN("a file of numbers on many lines")
+    {
+        string content;
+        for(auto i = 0; i < 1000; ++i) content += fmt::format("{} {}\n", i, -i);
+
+        const temp_file file{"stdsharp_read_all_parallel.txt", content};
+        const auto expected = read_all<int>(file.path());
+
+        THEN("ordered parts keep the file order")
+        {
+            for(const size_t thread_count : {1, 3, 7, 2000})
+                REQUIRE(
+                    read_all_parallel<int>(file.path(), {.thread_count = thread_count}) ==
+                    expected //
+                );
+        }
+
+        AND_THEN("unordered parts have the same elements")
+        {
+            auto values =
+                read_all_parallel<int>(file.path(), {.thread_count = 4, .ordered = false});
+            auto sorted = expected;
+
+            ::std::ranges::sort(values);
+            ::std::ranges::sort(sorted);
+            REQUIRE(values == sorted);
+        }
+    }
+
+    GIVEN("a file of words on many lines")
+    {
+        string content;
+        for(auto i = 0; i < 1000; ++i) content += fmt::format("word_{}\n", i);
+
+        const temp_file file{"stdsharp_read_all_parallel_words.txt", content};
+
+        THEN("parts parsed by the stream don't end with an empty element")
+        {
+            const auto expected = read_all<string>(file.path());
+
+            REQUIRE(expected.size() == 1000);
+            REQUIRE(expected.back() == "word_999");
+
+            for(const size_t thread_count : {1, 4, 7})
+                REQUIRE(
+                    read_all_parallel<string>(file.path(), {.thread_count = thread_count}) ==
+                    expected //
+                );
+        }
+    }
+
+    GIVEN("an empty file and a file without trailing line break")
+    {
+        const temp_file empty{"stdsharp_read_all_parallel_empty.txt", ""};
+        const temp_file last{"stdsharp_read_all_parallel_last.txt", "1\n2\n3"};
+
+        THEN("both are read whole")
+        {
+            REQUIRE(read_all_parallel<int>(empty.path()).empty());
+            REQUIRE(read_all_parallel<int>(last.path(), {.thread_count = 2}) == vector{1, 2, 3});
+        }
+    }
+}
+
+SCENARIO("read numbers from large files", "[.benchmark][fstream]") // NOLINT
+{
+    constexpr auto count = 1'000'000;
+
+    string content;
+    for(auto i = 0; i < count; ++i) content += fmt::format("{}\n", i * 31);
+
+    const temp_file file{"stdsharp_read_all_bench.txt", content};
+
+    BENCHMARK("operator>> per element")
+    {
+        ifstream fs{file.path()};
+        vector<int> values;
+        for(int value{}; fs >> value;) values.push_back(value);
+        return values.size();
+    };
+
+    BENCHMARK("read_all chunked from_chars") { return read_all<int>(file.path()).size(); };
+
+    BENCHMARK("read_all_parallel") { return read_all_parallel<int>(file.path()).size(); };
+}
+
+SCENARIO("read many small files", "[.benchmark][fstream]") // NOLINT
+{
+    constexpr auto count = 1000;
+
+    vector<unique_ptr<temp_file>> files;
+    vector<filesystem::path> paths;
+
+    for(auto i = 0; i < count; ++i)
+    {
+        files.push_back(make_unique<temp_file>(
+            fmt::format("stdsharp_async_read_bench_{}.txt", i),
+            string(static_cast<size_t>(i % 8 + 1) << 9U, 'x')
+        ));
+        paths.push_back(files.back()->path());
+    }
+
+    BENCHMARK("read_all_text one by one")
+    {
+        size_t size = 0;
+        for(const auto& path : paths) size += read_all_text(path).size();
+        return size;
+    };
+
+    for(const auto queue_depth : {0U, async_file_reader::default_queue_depth})
+    {
+        async_file_reader reader{queue_depth};
+
+        BENCHMARK(fmt::format("async_file_reader read_texts, io_uring {}", reader.uses_io_uring()))
+        {
+            size_t size = 0;
+            for(auto& future : reader.read_texts(paths)) size += future.get().size();
+            return size;
+        };
+    }
+}
+
+SCENARIO("read all text from large files", "[.benchmark][fstream]") // NOLINT
+{
+    for(const auto mega_bytes : {1, 64})
+    {
+        const temp_file file{
+            "stdsharp_read_all_text_bench.txt",
+            string(static_cast<size_t>(mega_bytes) << 20, 'x') //
+        };
+
+        BENCHMARK(fmt::format("istream getline {} MB", mega_bytes))
+        {
+            ifstream fs{file.path()};
+            string str;
+            getline(fs, str, '\0');
+            return str.size();
+        };
+
+        BENCHMARK(fmt::format("read_all_text {} MB", mega_bytes))
+        {
+            return read_all_text(file.path()).size();
+        };
+
+        BENCHMARK(fmt::format("read_all_mapped scan {} MB", mega_bytes))
+        {
+            const auto mapped = read_all_mapped(file.path());
+            return ::std::ranges::count(mapped, 'x');
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <map>
+#include <thread>
+
+#include "stdsharp/memory/monotonic_resource.h"
+#include "stdsharp/memory/pool_resource.h"
+#include "test.h"
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: resource allocator",
+    "[memory]",
+    monotonic_resource,
+    pool_resource<>,
+    concurrent_pool_resource<> //
+)
+{
+    using allocator = resource_allocator<int, TestType>;
+
+    STATIC_REQUIRE(memory_resource_req<TestType>);
+    STATIC_REQUIRE(allocator_req<allocator>);
+    STATIC_REQUIRE(allocator_req<resource_allocator<string, TestType>>);
+
+    TestType resource;
+    TestType other_resource;
+
+    GIVEN("containers using the resource")
+    {
+        vector<int, allocator> v{allocator{resource}};
+        map<int, int, less<>, resource_allocator<pair<const int, int>, TestType>> m{
+            allocator{resource} //
+        };
+
+        for(auto i = 0; i < 1000; ++i)
+        {
+            v.push_back(i);
+            m.emplace(i, i);
+        }
+
+        THEN("elements are stored")
+        {
+            REQUIRE(v.size() == 1000);
+            REQUIRE(v.back() == 999);
+            REQUIRE(m.size() == 1000);
+            REQUIRE(m.at(500) == 500);
+        }
+
+        AND_THEN("allocator propagates on move and swap but not on copy")
+        {
+            vector<int, allocator> other{{1, 2}, allocator{other_resource}};
+
+            other = v;
+            REQUIRE(other.get_allocator() == allocator{other_resource});
+            REQUIRE(other == v);
+
+            other = ::std::move(v);
+            REQUIRE(other.get_allocator() == allocator{resource});
+
+            other.swap(v);
+            REQUIRE(v.get_allocator() == allocator{resource});
+            REQUIRE(v.size() == 1000);
+        }
+    }
+
+    GIVEN("over-aligned and large allocations")
+    {
+        constexpr auto alignment = 256;
+        constexpr auto large_size = 4096;
+
+        auto* const aligned = resource.allocate(8, alignment);
+        auto* const large = resource.allocate(large_size, alignof(max_align_t));
+
+        THEN("alignment is respected")
+        {
+            REQUIRE(reinterpret_cast<uintptr_t>(aligned) % alignment == 0); // NOLINT
+            resource.deallocate(aligned, 8, alignment);
+            resource.deallocate(large, large_size, alignof(max_align_t));
+        }
+    }
+}
+
+SCENARIO("monotonic resource", "[memory]") // NOLINT
+{
+    GIVEN("a monotonic resource")
+    {
+        monotonic_resource resource;
+
+        THEN("allocations too large to ever succeed throw instead of hanging")
+        {
+            constexpr auto max = numeric_limits<size_t>::max();
+
+            REQUIRE_THROWS_AS(resource.allocate(max), bad_alloc);
+            REQUIRE_THROWS_AS(resource.allocate(max / 2 + 1), bad_alloc);
+            REQUIRE_THROWS_AS(resource.allocate(8, max), bad_alloc);
+
+            // still usable afterwards
+            REQUIRE(resource.allocate(8) != nullptr);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: pool resource",
+    "[memory]",
+    pool_resource<>,
+    concurrent_pool_resource<> //
+)
+{
+    TestType resource;
+
+    GIVEN("a deallocated block")
+    {
+        auto* const block = resource.allocate(sizeof(int), alignof(int));
+
+        resource.deallocate(block, sizeof(int), alignof(int));
+
+        THEN("it is reused by the next allocation of the same size class")
+        {
+            REQUIRE(resource.allocate(sizeof(u64), alignof(u64)) == block);
+        }
+    }
+}
+
+SCENARIO("concurrent pool resource", "[memory]") // NOLINT
+{
+    GIVEN("threads allocating and deallocating from the same pool")
+    {
+        constexpr auto thread_count = 4;
+        constexpr auto block_count = 256;
+        constexpr auto loop = 100;
+
+        concurrent_pool_resource<> resource;
+        ::std::atomic_bool overlapped = false;
+        vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+            threads.emplace_back(
+                [&, i]
+                {
+                    vector<int*> blocks(block_count);
+
+                    for(auto j = 0; j < loop; ++j)
+                    {
+                        for(auto& block : blocks)
+                            block = ::new(resource.allocate(sizeof(int), alignof(int))) int{i};
+
+                        for(auto* const block : blocks)
+                        {
+                            if(*block != i) overlapped = true;
+                            resource.deallocate(block, sizeof(int), alignof(int));
+                        }
+                    }
+                } //
+            );
+
+        for(auto& t : threads) t.join();
+
+        THEN("no block is handed out twice") { REQUIRE(!overlapped); }
+    }
+}
+
+namespace
+{
+    // appends with 1.5x growth and returns the number of reallocations
+    template<bool AtLeast, typename Allocator>
+    auto append_reallocations(Allocator alloc, const size_t count)
+    {
+        using traits = stdsharp::allocator_traits<Allocator>;
+
+        typename traits::pointer data = nullptr;
+        size_t capacity = 0;
+        size_t reallocations = 0;
+
+        for(size_t size = 0; size < count; ++size)
+        {
+            if(size == capacity)
+            {
+                const auto requested = capacity + capacity / 2 + 1;
+                const auto [new_data, new_capacity] = AtLeast ?
+                    traits::allocate_at_least(alloc, requested) :
+                    allocation_result{traits::allocate(alloc, requested), requested};
+
+                if(data != nullptr)
+                {
+                    ::std::copy_n(data, size, new_data);
+                    traits::deallocate(alloc, data, capacity);
+                    ++reallocations;
+                }
+
+                data = new_data;
+                capacity = new_capacity;
+            }
+
+            data[size] = static_cast<typename traits::value_type>(size);
+        }
+
+        traits::deallocate(alloc, data, capacity);
+
+        return reallocations;
+    }
+}
+
+SCENARIO("allocate at least", "[memory]") // NOLINT
+{
+    GIVEN("an allocator without allocate_at_least")
+    {
+        allocator<int> alloc;
+
+        THEN("the requested count is returned")
+        {
+            const auto [ptr, count] =
+                stdsharp::allocator_traits<allocator<int>>::allocate_at_least(alloc, 3);
+
+            REQUIRE(count == 3);
+            alloc.deallocate(ptr, count);
+        }
+    }
+
+    GIVEN("a pool allocator")
+    {
+        pool_resource<> resource;
+        pool_allocator<int> alloc{resource};
+
+        THEN("the size is rounded up to the block size")
+        {
+            const auto [ptr, count] =
+                stdsharp::allocator_traits<pool_allocator<int>>::allocate_at_least(alloc, 3);
+
+            REQUIRE(count == 4);
+            alloc.deallocate(ptr, count);
+        }
+
+        AND_THEN("appending reallocates less often when the slack is used")
+        {
+            REQUIRE(
+                append_reallocations<true>(alloc, 100) < append_reallocations<false>(alloc, 100)
+            );
+        }
+    }
+}
+
+SCENARIO("allocate at least append", "[.benchmark][memory]") // NOLINT
+{
+    pool_resource<> resource;
+    const pool_allocator<int> alloc{resource};
+
+    BENCHMARK("allocate") { return append_reallocations<false>(alloc, 100); };
+
+    BENCHMARK("allocate_at_least") { return append_reallocations<true>(alloc, 100); };
+}
+
+namespace
+{
+    constexpr auto churn_count = 1000;
+
+    template<typename Allocator>
+    auto vector_churn(const Allocator& alloc)
+    {
+        vector<int, Allocator> v{alloc};
+        for(auto i = 0; i < churn_count; ++i) v.push_back(i);
+        return v.size();
+    }
+
+    template<typename Allocator>
+    auto map_churn(const Allocator& alloc)
+    {
+        map<int, int, less<>, Allocator> m{alloc};
+
+        for(auto i = 0; i < churn_count; ++i) m.emplace(i, i);
+        for(auto i = 0; i < churn_count; i += 2) m.erase(i);
+        for(auto i = 0; i < churn_count; i += 2) m.emplace(i, i);
+
+        return m.size();
+    }
+
+    template<typename Resource>
+    void resource_churn(Resource& resource)
+    {
+        BENCHMARK("vector churn")
+        {
+            return vector_churn(resource_allocator<int, Resource>{resource});
+        };
+
+        BENCHMARK("map churn")
+        {
+            return map_churn(resource_allocator<pair<const int, int>, Resource>{resource});
+        };
+    }
+}
+
+SCENARIO("memory resource churn", "[.benchmark][memory]") // NOLINT
+{
+    SECTION("std::allocator")
+    {
+        BENCHMARK("vector churn") { return vector_churn(allocator<int>{}); };
+
+        BENCHMARK("map churn") { return map_churn(allocator<pair<const int, int>>{}); };
+    }
+
+    SECTION("monotonic_resource")
+    {
+        monotonic_resource resource;
+        resource_churn(resource);
+    }
+
+    SECTION("pool_resource")
+    {
+        pool_resource<> resource;
+        resource_churn(resource);
+    }
+
+    SECTION("concurrent_pool_resource")
+    {
+        concurrent_pool_resource<> resource;
+        resource_churn(resource);
+    }
+}
\ No newline at end of file
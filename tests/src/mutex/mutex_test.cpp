@@ -0,0 +1,160 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/mutex/async_shared_mutex.h"
+#include "stdsharp/mutex/hybrid_mutex.h"
+#include "stdsharp/mutex/ticket_mutex.h"
+#include "stdsharp/mutex/writer_preferring_shared_mutex.h"
+#include "stdsharp/concurrent_object.h"
+#include "test.h"
+
+namespace
+{
+    template<typename Mutex>
+    void contended_increment(Mutex& mutex, int& value, const unsigned thread_count, const int loop)
+    {
+        ::std::vector<::std::thread> threads;
+
+        threads.reserve(thread_count);
+
+        for(auto i = 0u; i < thread_count; ++i)
+            threads.emplace_back(
+                [&]
+                {
+                    for(auto j = 0; j < loop; ++j)
+                    {
+                        const ::std::unique_lock lock{mutex};
+                        ++value;
+                    }
+                } //
+            );
+
+        for(auto& t : threads) t.join();
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: spin based mutex",
+    "[mutex]",
+    spin_mutex,
+    hybrid_mutex,
+    ticket_mutex,
+    writer_preferring_shared_mutex,
+    async_shared_mutex //
+)
+{
+    STATIC_REQUIRE(concepts::mutex<TestType>);
+
+    GIVEN("a locked mutex")
+    {
+        TestType mutex;
+
+        mutex.lock();
+
+        THEN("try lock fails until unlocked")
+        {
+            REQUIRE(!mutex.try_lock());
+            mutex.unlock();
+            REQUIRE(mutex.try_lock());
+            mutex.unlock();
+        }
+    }
+
+    GIVEN("multiple threads increment a value")
+    {
+        constexpr auto thread_count = 4u;
+        constexpr auto loop = 10'000;
+
+        TestType mutex;
+        int value = 0;
+
+        contended_increment(mutex, value, thread_count, loop);
+
+        THEN("every increment is applied") { REQUIRE(value == thread_count * loop); }
+    }
+}
+
+SCENARIO("writer preferring shared mutex", "[mutex]") // NOLINT
+{
+    STATIC_REQUIRE(concepts::shared_mutex<writer_preferring_shared_mutex>);
+    STATIC_REQUIRE(concepts::shared_mutex<::std::shared_mutex>);
+    STATIC_REQUIRE(concepts::shared_mutex<async_shared_mutex>);
+
+    GIVEN("a shared locked mutex")
+    {
+        writer_preferring_shared_mutex mutex;
+
+        mutex.lock_shared();
+
+        THEN("other readers can enter but writer can't")
+        {
+            REQUIRE(mutex.try_lock_shared());
+            REQUIRE(!mutex.try_lock());
+
+            mutex.unlock_shared();
+            mutex.unlock_shared();
+
+            REQUIRE(mutex.try_lock());
+            REQUIRE(!mutex.try_lock_shared());
+
+            mutex.unlock();
+        }
+
+        AND_THEN("a waiting writer blocks new readers")
+        {
+            ::std::atomic_bool written = false;
+            ::std::thread writer{
+                [&]
+                {
+                    mutex.lock();
+                    written = true;
+                    mutex.unlock();
+                } //
+            };
+
+            while(mutex.try_lock_shared())
+            {
+                mutex.unlock_shared();
+                ::std::this_thread::yield();
+            }
+
+            mutex.unlock_shared();
+            writer.join();
+
+            REQUIRE(written);
+        }
+    }
+
+    GIVEN("a concurrent object using writer preferring shared mutex")
+    {
+        concurrent_object<int, writer_preferring_shared_mutex> object{1};
+
+        object.write([](auto& v) { ++*v; });
+        object.read([](const auto& v) { REQUIRE(*v == 2); });
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: mutex contention",
+    "[.benchmark][mutex]",
+    ::std::mutex,
+    spin_mutex,
+    hybrid_mutex,
+    ticket_mutex,
+    writer_preferring_shared_mutex //
+)
+{
+    constexpr auto loop = 10'000;
+
+    TestType mutex;
+    int value = 0;
+
+    BENCHMARK("low contention")
+    {
+        contended_increment(mutex, value, 1, loop);
+    };
+
+    BENCHMARK("high contention")
+    {
+        contended_increment(mutex, value, ::std::thread::hardware_concurrency(), loop);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/mutex/sharded_shared_mutex.h"
+#include "stdsharp/concurrent_object.h"
+#include "test.h"
+
+SCENARIO("sharded shared mutex", "[mutex]") // NOLINT
+{
+    using mutex_t = sharded_shared_mutex<>;
+
+    STATIC_REQUIRE(concepts::mutex<mutex_t>);
+    STATIC_REQUIRE(concepts::shared_lockable<mutex_t>);
+
+    GIVEN("a concurrent object using sharded shared mutex")
+    {
+        concurrent_object<int, mutex_t> object{0};
+
+        WHEN("writers and readers run concurrently")
+        {
+            constexpr auto thread_count = 4;
+            constexpr auto loop_count = 1000;
+
+            ::std::atomic_bool invalid_read = false;
+            ::std::vector<::std::thread> threads;
+
+            for(auto i = 0; i < thread_count; ++i)
+            {
+                threads.emplace_back(
+                    [&object]
+                    {
+                        for(auto j = 0; j < loop_count; ++j)
+                            object.write([](optional<int>& v) { ++*v; });
+                    } //
+                );
+                threads.emplace_back(
+                    [&object, &invalid_read]
+                    {
+                        for(auto j = 0; j < loop_count; ++j)
+                            object.read(
+                                [&invalid_read](const optional<int>& v)
+                                {
+                                    if(*v < 0 || *v > thread_count * loop_count)
+                                        invalid_read = true;
+                                } //
+                            );
+                    } //
+                );
+            }
+
+            for(auto& t : threads) t.join();
+
+            THEN("every write is observed exactly once")
+            {
+                REQUIRE(!invalid_read);
+                object.read(
+                    [](const optional<int>& v) { REQUIRE(*v == thread_count * loop_count); } //
+                );
+            }
+        }
+    }
+}
+
+namespace
+{
+    template<typename Object>
+    void concurrent_read(const Object& object, const unsigned thread_count)
+    {
+        constexpr auto loop_count = 100'000;
+
+        ::std::vector<::std::thread> threads;
+
+        threads.reserve(thread_count);
+
+        for(auto i = 0u; i < thread_count; ++i)
+            threads.emplace_back(
+                [&object]
+                {
+                    for(auto j = 0; j < loop_count; ++j)
+                        object.read([](const auto& v) { Catch::Benchmark::deoptimize_value(*v); });
+                } //
+            );
+
+        for(auto& t : threads) t.join();
+    }
+}
+
+SCENARIO("concurrent object read scaling", "[.benchmark][mutex]") // NOLINT
+{
+    const concurrent_object<int> default_object{0};
+    const concurrent_object<int, sharded_shared_mutex<>> sharded_object{0};
+
+    for(auto thread_count = 1u; thread_count <= ::std::thread::hardware_concurrency();
+        thread_count *= 2)
+    {
+        BENCHMARK(fmt::format("std::shared_mutex {} threads", thread_count))
+        {
+            concurrent_read(default_object, thread_count);
+        };
+
+        BENCHMARK(fmt::format("sharded_shared_mutex {} threads", thread_count))
+        {
+            concurrent_read(sharded_object, thread_count);
+        };
+    }
+}
\ No newline at end of file
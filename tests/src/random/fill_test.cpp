@@ -0,0 +1,235 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <numeric>
+
+#include "stdsharp/random/fill.h"
+#include "test.h"
+
+SCENARIO("xoshiro256** lanes", "[random]") // NOLINT
+{
+    STATIC_REQUIRE(uniform_random_bit_generator<xoshiro256starstar_x4>);
+
+    GIVEN("a four lane engine")
+    {
+        xoshiro256starstar_x4 engine{42};
+
+        THEN("each lane is a jumped xoshiro256** stream")
+        {
+            ::std::array<xoshiro256starstar, 4> streams{};
+            xoshiro256starstar stream{42};
+
+            for(auto& s : streams)
+            {
+                s = stream;
+                stream.jump();
+            }
+
+            for(auto i = 0; i < 100; ++i)
+                for(auto& s : streams) REQUIRE(engine() == s());
+        }
+
+        AND_THEN("fill produces the same sequence as repeated calls")
+        {
+            auto copy = engine;
+            ::std::vector<::std::uint64_t> filled(103);
+
+            static_cast<void>(engine());
+            static_cast<void>(copy());
+            engine.fill(filled);
+
+            for(const auto word : filled) REQUIRE(word == copy());
+            REQUIRE(engine == copy);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: fill uniform integers", //
+    "[random]",
+    ::std::int8_t,
+    ::std::uint16_t,
+    int,
+    unsigned,
+    ::std::int64_t,
+    ::std::uint64_t //
+)
+{
+    GIVEN("a small range")
+    {
+        const auto [min, max] = is_signed_v<TestType> ? //
+            pair<TestType, TestType>{-3, 2} :
+            pair<TestType, TestType>{5, 10};
+        xoshiro256starstar_x4 engine{1};
+        ::std::vector<TestType> values(60'000);
+
+        fill_uniform(::std::span{values}, min, max, engine);
+
+        THEN("every value is in range with about the same frequency")
+        {
+            ::std::array<int, 6> counts{};
+
+            for(const auto v : values)
+            {
+                REQUIRE(v >= min);
+                REQUIRE(v <= max);
+                ++counts[static_cast<size_t>(v - min)];
+            }
+
+            for(const auto count : counts) REQUIRE(::std::abs(count - 10'000) < 500);
+        }
+
+        AND_THEN("the same seed gives the same values with any engine")
+        {
+            const auto in_range = [=](const auto v) { return v >= min && v <= max; };
+            auto copy = values;
+            xoshiro256starstar_x4 same{1};
+            mt19937 mt{1};
+
+            fill_uniform(::std::span{copy}, min, max, same);
+            REQUIRE(copy == values);
+
+            fill_uniform(::std::span{copy}, min, max, mt);
+            REQUIRE(::std::ranges::all_of(copy, in_range));
+        }
+    }
+
+    GIVEN("the full range")
+    {
+        constexpr auto min = numeric_limits<TestType>::min();
+        constexpr auto max = numeric_limits<TestType>::max();
+        xoshiro256starstar engine{2};
+        ::std::vector<TestType> values(1000);
+
+        fill_uniform(::std::span{values}, min, max, engine);
+
+        THEN("values spread over the whole range")
+        {
+            REQUIRE(*::std::ranges::min_element(values) < min / 2 + max / 4);
+            REQUIRE(*::std::ranges::max_element(values) > max / 2 + max / 4);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Scenario: fill uniform reals", "[random]", float, double) // NOLINT
+{
+    GIVEN("a range")
+    {
+        xoshiro256starstar_x4 engine{3};
+        ::std::vector<TestType> values(100'001);
+
+        fill_uniform(::std::span{values}, -2, 6, engine);
+
+        THEN("values are in range with the expected mean")
+        {
+            REQUIRE(::std::ranges::all_of(values, [](const auto v) { return v >= -2 && v < 6; }));
+
+            const auto mean = ::std::reduce(values.begin(), values.end(), 0.0) / values.size();
+
+            REQUIRE(::std::abs(mean - 2) < 0.05);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Scenario: fill normal reals", "[random]", float, double) // NOLINT
+{
+    GIVEN("standard normal values")
+    {
+        xoshiro256starstar_x4 engine{4};
+        ::std::vector<TestType> values(400'000);
+
+        fill_normal(::std::span{values}, 1, 2, engine);
+
+        THEN("the moments and tails match")
+        {
+            auto sum = 0.0;
+            auto squares = 0.0;
+            size_t tail = 0;
+
+            for(const auto v : values)
+            {
+                const auto z = (v - 1.0) / 2;
+
+                sum += z;
+                squares += z * z;
+                if(::std::abs(z) > 3.442619855899) ++tail; // beyond the ziggurat base
+            }
+
+            const auto mean = sum / values.size();
+            const auto variance = squares / values.size() - mean * mean;
+
+            REQUIRE(::std::abs(mean) < 0.01);
+            REQUIRE(::std::abs(variance - 1) < 0.01);
+
+            // 2 * (1 - Phi(3.4426)) = 5.76e-4
+            REQUIRE(tail > 150);
+            REQUIRE(tail < 320);
+        }
+    }
+}
+
+SCENARIO("fill random throughput", "[.benchmark][random]") // NOLINT
+{
+    const ::std::uint64_t seed = get_random_device()();
+    ::std::vector<double> doubles(1 << 16);
+    ::std::vector<::std::uint32_t> ints(1 << 16);
+
+    BENCHMARK("uniform_real_distribution with mt19937_64")
+    {
+        mt19937_64 engine{seed};
+        uniform_real_distribution<double> dist{0, 1};
+        for(auto& d : doubles) d = dist(engine);
+        return doubles.back();
+    };
+
+    BENCHMARK("uniform_real_distribution with xoshiro256**")
+    {
+        xoshiro256starstar engine{seed};
+        uniform_real_distribution<double> dist{0, 1};
+        for(auto& d : doubles) d = dist(engine);
+        return doubles.back();
+    };
+
+    BENCHMARK("fill_uniform double with xoshiro256**")
+    {
+        xoshiro256starstar engine{seed};
+        fill_uniform(::std::span{doubles}, 0, 1, engine);
+        return doubles.back();
+    };
+
+    BENCHMARK("fill_uniform double with xoshiro256** lanes")
+    {
+        xoshiro256starstar_x4 engine{seed};
+        fill_uniform(::std::span{doubles}, 0, 1, engine);
+        return doubles.back();
+    };
+
+    BENCHMARK("uniform_int_distribution with mt19937_64")
+    {
+        mt19937_64 engine{seed};
+        uniform_int_distribution<::std::uint32_t> dist{0, 999};
+        for(auto& i : ints) i = dist(engine);
+        return ints.back();
+    };
+
+    BENCHMARK("fill_uniform uint32_t with xoshiro256** lanes")
+    {
+        xoshiro256starstar_x4 engine{seed};
+        fill_uniform(::std::span{ints}, 0, 999, engine);
+        return ints.back();
+    };
+
+    BENCHMARK("normal_distribution with mt19937_64")
+    {
+        mt19937_64 engine{seed};
+        normal_distribution<double> dist{0, 1};
+        for(auto& d : doubles) d = dist(engine);
+        return doubles.back();
+    };
+
+    BENCHMARK("fill_normal double with xoshiro256** lanes")
+    {
+        xoshiro256starstar_x4 engine{seed};
+        fill_normal(::std::span{doubles}, 0, 1, engine);
+        return doubles.back();
+    };
+}
\ No newline at end of file
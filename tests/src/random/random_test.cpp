@@ -0,0 +1,146 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <set>
+#include <thread>
+
+#include "stdsharp/random/random.h"
+#include "test.h"
+
+TEMPLATE_TEST_CASE( // NOLINT
+    "Scenario: random engines", //
+    "[random]",
+    splitmix64,
+    xoshiro256starstar,
+    pcg64 //
+)
+{
+    STATIC_REQUIRE(uniform_random_bit_generator<TestType>);
+
+    GIVEN("engines with the same and different seeds")
+    {
+        TestType engine{42};
+        TestType same{42};
+        TestType other{43};
+
+        THEN("the same seed reproduces the sequence")
+        {
+            for(auto i = 0; i < 100; ++i) REQUIRE(engine() == same());
+
+            REQUIRE(engine == same);
+        }
+
+        AND_THEN("different seeds give different sequences")
+        {
+            REQUIRE(engine() != other());
+        }
+
+        AND_THEN("discard skips draws")
+        {
+            engine.discard(1000);
+            for(auto i = 0; i < 1000; ++i) same();
+
+            REQUIRE(engine == same);
+            REQUIRE(engine() == same());
+        }
+    }
+}
+
+SCENARIO("random engine reference values", "[random]") // NOLINT
+{
+    GIVEN("splitmix64 seeded with 0")
+    {
+        splitmix64 engine{0};
+
+        THEN("the reference sequence is generated")
+        {
+            REQUIRE(engine() == 0xE220'A839'7B1D'CDAF);
+            REQUIRE(engine() == 0x6E78'9E6A'A1B9'65F4);
+            REQUIRE(engine() == 0x06C4'5D18'8009'454F);
+        }
+    }
+
+    GIVEN("xoshiro256** with state {1, 2, 3, 4}")
+    {
+        xoshiro256starstar engine{::std::array<::std::uint64_t, 4>{1, 2, 3, 4}};
+
+        THEN("the reference sequence is generated")
+        {
+            REQUIRE(engine() == 11520);
+            REQUIRE(engine() == 0);
+            REQUIRE(engine() == 1509978240);
+            REQUIRE(engine() == 0x10E0'0000'0000'9D80);
+        }
+
+        AND_THEN("jump moves to the reference state")
+        {
+            engine.jump();
+
+            REQUIRE(
+                engine.state() ==
+                ::std::array<::std::uint64_t, 4>{
+                    0x8C7A'1539'56B5'F3D1,
+                    0x701F'1A71'3401'D85E,
+                    0x6527'F66A'6546'9085,
+                    0x8386'B786'C440'8050 //
+                }
+            );
+            REQUIRE(engine() == 0xBBD2'F312'2984'43D8);
+        }
+    }
+
+    GIVEN("pcg64 seeded with 42 on stream 54")
+    {
+        pcg64 engine{42, 54};
+
+        THEN("the reference sequence is generated")
+        {
+            REQUIRE(engine() == 0x86B1'DA1D'7206'2B68);
+            REQUIRE(engine() == 0x1304'AA46'C985'3D39);
+            REQUIRE(engine() == 0xA367'0E9E'0DD5'0358);
+            REQUIRE(engine() == 0xF909'0E52'9A7D'AE00);
+        }
+
+        AND_THEN("other streams are different")
+        {
+            REQUIRE(pcg64{42, 55}() != engine());
+        }
+    }
+
+    GIVEN("the thread local engine")
+    {
+        THEN("each thread is seeded differently")
+        {
+            ::std::array<::std::uint64_t, 4> draws{};
+            ::std::vector<::std::thread> threads;
+
+            for(auto& draw : draws) threads.emplace_back([&draw] { draw = get_random_engine()(); });
+            for(auto& thread : threads) thread.join();
+
+            REQUIRE(::std::set(draws.begin(), draws.end()).size() == draws.size());
+            REQUIRE(&get_random_engine() == &get_random_engine());
+        }
+    }
+}
+
+SCENARIO("random engine throughput", "[.benchmark][random]") // NOLINT
+{
+    constexpr auto count = 1 << 16;
+    const ::std::uint64_t seed = get_random_device()();
+
+    const auto sum = [](auto engine)
+    {
+        ::std::uint64_t sum = 0;
+        for(auto i = 0; i < count; ++i) sum += engine();
+        return sum;
+    };
+
+    BENCHMARK("mt19937_64") { return sum(mt19937_64{seed}); };
+
+    BENCHMARK("splitmix64") { return sum(splitmix64{seed}); };
+
+    BENCHMARK("xoshiro256**") { return sum(xoshiro256starstar{seed}); };
+
+    BENCHMARK("pcg64") { return sum(pcg64{seed}); };
+
+    BENCHMARK("random_device") { return sum(::std::ref(get_random_device())) % 2; };
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <list>
+
+#include "stdsharp/random/sampling.h"
+#include "test.h"
+
+namespace
+{
+    // counts the draws of the wrapped engine
+    struct counting_engine
+    {
+        using result_type = xoshiro256starstar::result_type;
+
+        xoshiro256starstar engine;
+        size_t draws = 0;
+
+        static constexpr auto min() noexcept { return xoshiro256starstar::min(); }
+
+        static constexpr auto max() noexcept { return xoshiro256starstar::max(); }
+
+        result_type operator()() noexcept
+        {
+            ++draws;
+            return engine();
+        }
+    };
+}
+
+SCENARIO("alias table", "[random]") // NOLINT
+{
+    GIVEN("weights 1, 0, 2, 3 and 4")
+    {
+        const alias_table table{1, 0, 2, 3, 4};
+        xoshiro256starstar engine{1};
+
+        THEN("indices are drawn in proportion to their weights")
+        {
+            ::std::array<int, 5> counts{};
+
+            for(auto i = 0; i < 100'000; ++i) ++counts[table(engine)];
+
+            REQUIRE(counts[1] == 0);
+            REQUIRE(::std::abs(counts[0] - 10'000) < 600);
+            REQUIRE(::std::abs(counts[2] - 20'000) < 800);
+            REQUIRE(::std::abs(counts[3] - 30'000) < 900);
+            REQUIRE(::std::abs(counts[4] - 40'000) < 1000);
+        }
+    }
+
+    GIVEN("integer weights in a vector and a single weight")
+    {
+        const alias_table table{::std::vector{5, 5, 5, 5}};
+        const alias_table single{::std::array{0.5}};
+        mt19937 engine{2};
+
+        THEN("any generator works")
+        {
+            ::std::array<int, 4> counts{};
+
+            for(auto i = 0; i < 40'000; ++i) ++counts[table(engine)];
+            for(const auto count : counts) REQUIRE(::std::abs(count - 10'000) < 600);
+
+            REQUIRE(table.size() == 4);
+            REQUIRE(single(engine) == 0);
+        }
+    }
+
+    GIVEN("invalid weights")
+    {
+        THEN("construction throws")
+        {
+            REQUIRE_THROWS_AS(alias_table{::std::vector<double>{}}, ::std::invalid_argument);
+            REQUIRE_THROWS_AS((alias_table{0, 0}), ::std::invalid_argument);
+            REQUIRE_THROWS_AS((alias_table{1, -1}), ::std::invalid_argument);
+            REQUIRE_THROWS_AS(
+                (alias_table{1, numeric_limits<double>::infinity()}),
+                ::std::invalid_argument
+            );
+        }
+    }
+}
+
+SCENARIO("reservoir sampler", "[random]") // NOLINT
+{
+    GIVEN("a stream shorter than the reservoir")
+    {
+        reservoir_sampler<int> sampler{10};
+        xoshiro256starstar engine{3};
+
+        for(auto i = 0; i < 5; ++i) sampler.push(i, engine);
+
+        THEN("every element is kept")
+        {
+            REQUIRE(::std::ranges::equal(sampler.sample(), ::std::array{0, 1, 2, 3, 4}));
+            REQUIRE(sampler.seen() == 5);
+        }
+    }
+
+    GIVEN("many streams of 100 elements")
+    {
+        xoshiro256starstar engine{4};
+        ::std::vector<int> stream(100);
+        ::std::list<int> list(100);
+
+        ::std::iota(stream.begin(), stream.end(), 0);
+        ::std::iota(list.begin(), list.end(), 0);
+
+        THEN("each element is kept with the same probability")
+        {
+            ::std::array<int, 100> pushed{};
+            ::std::array<int, 100> random_access{};
+            ::std::array<int, 100> forward{};
+
+            for(auto n = 0; n < 20'000; ++n)
+            {
+                reservoir_sampler<int> by_element{10};
+                reservoir_sampler<int> by_range{10};
+                reservoir_sampler<int> by_list{10};
+
+                for(const auto i : stream) by_element.push(i, engine);
+                by_range.push_range(stream, engine);
+                by_list.push_range(list, engine);
+
+                for(const auto i : by_element.sample()) ++pushed[static_cast<size_t>(i)];
+                for(const auto i : by_range.sample()) ++random_access[static_cast<size_t>(i)];
+                for(const auto i : by_list.sample()) ++forward[static_cast<size_t>(i)];
+
+                REQUIRE(by_range.seen() == 100);
+            }
+
+            for(size_t i = 0; i < 100; ++i)
+            {
+                REQUIRE(::std::abs(pushed[i] - 2000) < 200);
+                REQUIRE(::std::abs(random_access[i] - 2000) < 200);
+                REQUIRE(::std::abs(forward[i] - 2000) < 200);
+            }
+        }
+    }
+
+    GIVEN("a long stream")
+    {
+        counting_engine engine{xoshiro256starstar{5}};
+        reservoir_sampler<int> sampler{10};
+
+        for(auto i = 0; i < 1'000'000; ++i) sampler.push(i, engine);
+
+        THEN("random numbers are drawn only for kept elements")
+        {
+            // about 3 k log(n / k) draws
+            REQUIRE(engine.draws < 1000);
+            REQUIRE(sampler.sample().size() == 10);
+        }
+    }
+
+    GIVEN("zero capacity")
+    {
+        THEN("construction throws")
+        {
+            REQUIRE_THROWS_AS(reservoir_sampler<int>{0}, ::std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("weighted sampling throughput", "[.benchmark][random]") // NOLINT
+{
+    const ::std::uint64_t seed = get_random_device()();
+    ::std::vector<double> weights(1000);
+
+    {
+        xoshiro256starstar engine{seed};
+        fill_uniform(::std::span{weights}, 0, 1, engine);
+    }
+
+    constexpr auto count = 1 << 16;
+
+    BENCHMARK("discrete_distribution build")
+    {
+        return discrete_distribution<size_t>{weights.cbegin(), weights.cend()}.max();
+    };
+
+    BENCHMARK("alias_table build") { return alias_table{weights}.size(); };
+
+    const discrete_distribution<size_t> discrete{weights.cbegin(), weights.cend()};
+    const alias_table table{weights};
+
+    BENCHMARK("discrete_distribution sample")
+    {
+        xoshiro256starstar engine{seed};
+        auto dist = discrete;
+        size_t sum = 0;
+        for(auto i = 0; i < count; ++i) sum += dist(engine);
+        return sum;
+    };
+
+    BENCHMARK("alias_table sample")
+    {
+        xoshiro256starstar engine{seed};
+        size_t sum = 0;
+        for(auto i = 0; i < count; ++i) sum += table(engine);
+        return sum;
+    };
+
+    ::std::vector<int> stream(1 << 20);
+
+    ::std::iota(stream.begin(), stream.end(), 0);
+
+    BENCHMARK("reservoir by algorithm R")
+    {
+        xoshiro256starstar engine{seed};
+        ::std::vector<int> reservoir(stream.begin(), stream.begin() + 100);
+
+        for(size_t i = 100; i < stream.size(); ++i)
+        {
+            const auto j = uniform_int_distribution<size_t>{0, i}(engine);
+            if(j < reservoir.size()) reservoir[j] = stream[i];
+        }
+
+        return reservoir.front();
+    };
+
+    BENCHMARK("reservoir_sampler push")
+    {
+        xoshiro256starstar engine{seed};
+        reservoir_sampler<int> sampler{100};
+        for(const auto i : stream) sampler.push(i, engine);
+        return sampler.sample().front();
+    };
+
+    BENCHMARK("reservoir_sampler push_range")
+    {
+        xoshiro256starstar engine{seed};
+        reservoir_sampler<int> sampler{100};
+        sampler.push_range(stream, engine);
+        return sampler.sample().front();
+    };
+}
\ No newline at end of file
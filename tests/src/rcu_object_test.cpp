@@ -0,0 +1,113 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/rcu_object.h"
+#include "stdsharp/concurrent_object.h"
+#include "test.h"
+
+SCENARIO("rcu object", "[rcu object]") // NOLINT
+{
+    STATIC_REQUIRE(default_initializable<rcu_object<int>>);
+    STATIC_REQUIRE(copyable<rcu_object<int>>);
+    STATIC_REQUIRE(movable<rcu_object<int>>);
+
+    GIVEN("a rcu object holding a vector")
+    {
+        rcu_object<vector<int>> object{3, 1};
+
+        THEN("snapshot keeps previous value alive during write")
+        {
+            thread writer;
+
+            {
+                const auto& snapshot = object.snapshot();
+
+                writer = thread{[&object] { object.write([](auto& v) { v->push_back(2); }); }};
+
+                REQUIRE((*snapshot)->size() == 3);
+            }
+
+            writer.join();
+
+            object.read([](const auto& v) { REQUIRE(v->size() == 4); });
+        }
+
+        AND_THEN("read observes published value")
+        {
+            object.write([](auto& v) { v->push_back(2); });
+            object.read([](const auto& v) { REQUIRE(*v == vector{1, 1, 1, 2}); });
+        }
+
+        AND_THEN("member accessor reads the same as read")
+        {
+            object(reflection::member<"read"_ltr>)([](const auto& v) { REQUIRE(v->size() == 3); });
+        }
+    }
+
+    GIVEN("concurrent writers and readers")
+    {
+        rcu_object<pair<int, int>> object{0, 0};
+
+        constexpr auto thread_count = 4;
+        constexpr auto loop_count = 1000;
+
+        ::std::atomic_bool torn = false;
+        ::std::vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&object]
+                {
+                    for(auto j = 0; j < loop_count; ++j)
+                        object.write(
+                            [](auto& v)
+                            {
+                                ++v->first;
+                                ++v->second;
+                            } //
+                        );
+                } //
+            );
+            threads.emplace_back(
+                [&object, &torn]
+                {
+                    for(auto j = 0; j < loop_count; ++j)
+                        object.read(
+                            [&torn](const auto& v)
+                            {
+                                if(v->first != v->second) torn = true; //
+                            } //
+                        );
+                } //
+            );
+        }
+
+        for(auto& t : threads) t.join();
+
+        THEN("readers never observe partially written value")
+        {
+            REQUIRE(!torn);
+            object.read([](const auto& v) { REQUIRE(v->first == thread_count * loop_count); });
+        }
+    }
+}
+
+SCENARIO("rcu object read", "[.benchmark][rcu object]") // NOLINT
+{
+    const concurrent_object<int> locked_object{0};
+    const rcu_object<int> rcu{0};
+
+    BENCHMARK("concurrent_object read")
+    {
+        int v{};
+        locked_object.read([&v](const auto& value) { v = *value; });
+        return v;
+    };
+
+    BENCHMARK("rcu_object read")
+    {
+        int v{};
+        rcu.read([&v](const auto& value) { v = *value; });
+        return v;
+    };
+}
\ No newline at end of file
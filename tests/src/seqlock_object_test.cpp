@@ -0,0 +1,127 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "stdsharp/seqlock_object.h"
+#include "stdsharp/concurrent_object.h"
+#include "test.h"
+
+namespace
+{
+    struct quote
+    {
+        i64 bid;
+        i64 ask;
+        u64 timestamp;
+    };
+}
+
+SCENARIO("seqlock object", "[seqlock object]") // NOLINT
+{
+    STATIC_REQUIRE(default_initializable<seqlock_object<int>>);
+    STATIC_REQUIRE(copyable<seqlock_object<quote>>);
+    STATIC_REQUIRE(!constructible_from<seqlock_object<quote>, const vector<int>&>);
+
+    GIVEN("a seqlock object holding a quote")
+    {
+        seqlock_object<quote> object{quote{1, 2, 0}};
+
+        THEN("write is observed by read")
+        {
+            object.write([](optional<quote>& q) { ++q->timestamp; });
+            object.read([](const optional<quote>& q) { REQUIRE(q->timestamp == 1); });
+            REQUIRE(object.load()->ask == 2);
+        }
+    }
+
+    GIVEN("concurrent writers and readers")
+    {
+        seqlock_object<quote> object{quote{}};
+
+        constexpr auto thread_count = 4;
+        constexpr auto loop_count = 1000;
+
+        ::std::atomic_bool torn = false;
+        ::std::vector<::std::thread> threads;
+
+        for(auto i = 0; i < thread_count; ++i)
+        {
+            threads.emplace_back(
+                [&object]
+                {
+                    for(auto j = 0; j < loop_count; ++j)
+                        object.write(
+                            [](optional<quote>& q)
+                            {
+                                ++q->bid;
+                                ++q->ask;
+                                ++q->timestamp;
+                            } //
+                        );
+                } //
+            );
+            threads.emplace_back(
+                [&object, &torn]
+                {
+                    for(auto j = 0; j < loop_count; ++j)
+                        object.read(
+                            [&torn](const optional<quote>& q)
+                            {
+                                if(q->bid != q->ask || q->ask != static_cast<i64>(q->timestamp))
+                                    torn = true;
+                            } //
+                        );
+                } //
+            );
+        }
+
+        for(auto& t : threads) t.join();
+
+        THEN("readers never observe torn value")
+        {
+            REQUIRE(!torn);
+            REQUIRE(object.load()->timestamp == thread_count * loop_count);
+        }
+    }
+}
+
+namespace
+{
+    template<typename Object>
+    void read_with_contended_writer(Catch::Benchmark::Chronometer meter, Object& object)
+    {
+        ::std::atomic_bool stop = false;
+        ::std::thread writer{
+            [&]
+            {
+                while(!stop) object.write([](optional<quote>& q) { ++q->timestamp; });
+            } //
+        };
+
+        meter.measure(
+            [&object]
+            {
+                u64 timestamp{};
+                object.read([&timestamp](const optional<quote>& q) { timestamp = q->timestamp; });
+                return timestamp;
+            } //
+        );
+
+        stop = true;
+        writer.join();
+    }
+}
+
+SCENARIO("seqlock object read under contention", "[.benchmark][seqlock object]") // NOLINT
+{
+    concurrent_object<quote> locked_object{quote{}};
+    seqlock_object<quote> seqlock{quote{}};
+
+    BENCHMARK_ADVANCED("concurrent_object read")(Catch::Benchmark::Chronometer meter)
+    {
+        read_with_contended_writer(meter, locked_object);
+    };
+
+    BENCHMARK_ADVANCED("seqlock_object read")(Catch::Benchmark::Chronometer meter)
+    {
+        read_with_contended_writer(meter, seqlock);
+    };
+}
\ No newline at end of file